@@ -13,6 +13,34 @@ Modified (m) 2017 Thomas Wolff: revise Unicode and locale/wchar handling
 static const struct caseconv_entry table [] = {
 #include "caseconv.t"
 };
+
+#ifdef __FAST_WCTYPE
+
+#include "caseconv_page.h"
+
+#define N_PAGE_INDEX    (sizeof caseconv_page_index / sizeof caseconv_page_index[0])
+#define PAGE_MASK       ((1 << CASECONV_PAGE_SHIFT) - 1)
+
+const struct caseconv_entry *
+__caseconv_lookup (wint_t ucs, locale_t locale)
+{
+  uint16_t index;
+
+  if (ucs >= 0x80 && __locale_is_C(locale))
+    return 0;
+
+  if (ucs >= (N_PAGE_INDEX << CASECONV_PAGE_SHIFT))
+    return 0;
+
+  /* page entries hold the table index plus one, zero for no conversion */
+  index = caseconv_page[caseconv_page_index[ucs >> CASECONV_PAGE_SHIFT]][ucs & PAGE_MASK];
+  if (!index)
+    return 0;
+  return &table[index - 1];
+}
+
+#else
+
 #define first(ce)	((wint_t) ce.first)
 #define last(ce)	((wint_t) (ce.first + ce.diff))
 #define NCASECONV       (sizeof table / sizeof table[0])
@@ -42,3 +70,5 @@ __caseconv_lookup (wint_t ucs, locale_t locale)
     }
   return 0;
 }
+
+#endif /* __FAST_WCTYPE */
@@ -41,6 +41,35 @@
 
 #ifdef __MB_CAPABLE
 
+#ifdef __FAST_WCTYPE
+
+#include "ctype_page.h"
+
+#define N_PAGE_INDEX    (sizeof(ctype_page_index) / sizeof(ctype_page_index[0]))
+#define PAGE_MASK       ((1 << CTYPE_PAGE_SHIFT) - 1)
+
+uint16_t
+__ctype_table_lookup(wint_t ic, locale_t locale)
+{
+    wchar_t     c;
+
+    if (ic == WEOF)
+        return CLASS_none;
+
+    c = (wchar_t) ic;
+
+    /* Be compatible with glibc where the C locale has no classes outside of ASCII */
+    if (c >= 0x80 && __locale_is_C(locale))
+        return CLASS_none;
+
+    if ((wint_t) c >= (N_PAGE_INDEX << CTYPE_PAGE_SHIFT))
+        return CLASS_none;
+
+    return ctype_class[ctype_page[ctype_page_index[(wint_t) c >> CTYPE_PAGE_SHIFT]][c & PAGE_MASK]];
+}
+
+#else
+
 static const struct {
     wchar_t             code;
     uint16_t            category;
@@ -80,4 +109,6 @@ __ctype_table_lookup(wint_t ic, locale_t locale)
     }
     return ctype_table[high].category;
 }
+
+#endif /* __FAST_WCTYPE */
 #endif /* __MB_CAPABLE */
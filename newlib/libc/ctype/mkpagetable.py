@@ -0,0 +1,218 @@
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Copyright © 2026 Keith Packard
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+#    notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above
+#    copyright notice, this list of conditions and the following
+#    disclaimer in the documentation and/or other materials provided
+#    with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived
+#    from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+# INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+'''
+Convert the range tables generated by mkctype.py (ctype_table.h) and
+mkcaseconv (caseconv.t) into two-level page tables so that lookups
+are a pair of array references instead of a binary search.
+
+usage: mkpagetable.py ctype ctype_table.h > ctype_page.h
+       mkpagetable.py caseconv caseconv.t > caseconv_page.h
+'''
+
+import re
+import sys
+
+# Code points above this limit are not representable with 16-bit wchar_t
+BMP_LIMIT = 0x10000
+
+def load_ctype(name):
+    '''Return the class set for each code point as a string'''
+    ranges = []
+    skip = False
+    with open(name) as f:
+        for line in f:
+            # Use the full table, not the 16-bit wchar_t subset
+            if line.startswith('#if __SIZEOF_WCHAR_T__ == 2'):
+                skip = True
+                continue
+            if line.startswith('#else'):
+                skip = False
+                continue
+            if skip:
+                continue
+            m = re.match(r'\{ 0x([0-9a-f]+), (.*) \},', line)
+            if m:
+                # mkctype may repeat a flag; fold those so equal
+                # class sets share one ctype_class entry
+                flags = '|'.join(dict.fromkeys(m.group(2).split('|')))
+                ranges += [(int(m.group(1), 16), flags)]
+    values = []
+    for i in range(len(ranges) - 1):
+        values += [ranges[i][1]] * (ranges[i+1][0] - ranges[i][0])
+    return values
+
+def load_caseconv(name):
+    '''Return one plus the table index for each code point, zero for none'''
+    values = []
+    index = 0
+    with open(name) as f:
+        for line in f:
+            m = re.match(r'\s*\{(0x[0-9A-Fa-f]+), ([0-9]+),', line)
+            if m:
+                index += 1
+                first = int(m.group(1), 16)
+                last = first + int(m.group(2))
+                values += [0] * (first - len(values))
+                values += [index] * (last + 1 - first)
+    return values
+
+def c_type(max_value):
+    if max_value < 0x100:
+        return 'uint8_t'
+    return 'uint16_t'
+
+def paginate(values, shift, none):
+    size = 1 << shift
+    npages = (len(values) + size - 1) >> shift
+    pages = {}
+    index = []
+    for p in range(npages):
+        page = tuple(values[p * size : (p + 1) * size])
+        page += (none,) * (size - len(page))
+        if page not in pages:
+            pages[page] = len(pages)
+        index += [pages[page]]
+    return index, list(pages)
+
+def table_size(values, shift, none, entry_size):
+    index, pages = paginate(values, shift, none)
+    return len(index) * (1 if len(pages) < 0x100 else 2) + len(pages) * (1 << shift) * entry_size
+
+def best_shift(values, none, entry_size):
+    return min(range(4, 10), key=lambda shift: table_size(values, shift, none, entry_size))
+
+def dump_list(values, per_line, fmt):
+    for i in range(0, len(values), per_line):
+        print('    ' + ' '.join(fmt % v + ',' for v in values[i:i + per_line]))
+
+def dump_page_table(prefix, values, none, value_type, split_bmp):
+    entry_size = 1 if value_type == 'uint8_t' else 2
+    shift = best_shift(values, none, entry_size)
+    index, pages = paginate(values, shift, none)
+
+    # Pages are numbered in order of first use, so those needed only
+    # above the BMP come last and can be left out with 16-bit wchar_t
+    if split_bmp:
+        bmp_pages = max(index[:BMP_LIMIT >> shift]) + 1
+        bmp_index = BMP_LIMIT >> shift
+    else:
+        bmp_pages = len(pages)
+        bmp_index = len(index)
+
+    print('#define %s_PAGE_SHIFT %d' % (prefix.upper(), shift))
+    print()
+    print('static const %s %s_page_index[] = {' % (c_type(len(pages) - 1), prefix))
+    dump_list(index[:bmp_index], 16, '%3d')
+    if len(index) > bmp_index:
+        print('#if __SIZEOF_WCHAR_T__ != 2')
+        dump_list(index[bmp_index:], 16, '%3d')
+        print('#endif')
+    print('};')
+    print()
+    print('static const %s %s_page[][1 << %s_PAGE_SHIFT] = {' % (value_type, prefix, prefix.upper()))
+    for p, page in enumerate(pages):
+        if p == bmp_pages:
+            print('#if __SIZEOF_WCHAR_T__ != 2')
+        print('    {')
+        dump_list(page, 16, '%3d')
+        print('    },')
+    if len(pages) > bmp_pages:
+        print('#endif')
+    print('};')
+
+def dump_ctype(name):
+    values = load_ctype(name)
+    classes = ['CLASS_none'] + sorted(set(values) - {'CLASS_none'})
+    class_index = {c: i for i, c in enumerate(classes)}
+    print('static const uint16_t ctype_class[] = {')
+    for c in classes:
+        print('    %s,' % c)
+    print('};')
+    print()
+    dump_page_table('ctype', [class_index[v] for v in values], 0, c_type(len(classes) - 1), True)
+
+def dump_caseconv(name):
+    values = load_caseconv(name)
+    dump_page_table('caseconv', values, 0, c_type(max(values)), False)
+
+def dump_header():
+    print('''/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* This file is auto-generated from mkpagetable.py */
+''')
+
+if len(sys.argv) != 3 or sys.argv[1] not in ('ctype', 'caseconv'):
+    print('usage: %s ctype|caseconv <range table>' % sys.argv[0], file=sys.stderr)
+    sys.exit(1)
+
+dump_header()
+if sys.argv[1] == 'ctype':
+    dump_ctype(sys.argv[2])
+else:
+    dump_caseconv(sys.argv[2])
@@ -34,6 +34,326 @@
  */
 
 #include "iconv_private.h"
+#include <endian.h>
+
+#ifdef __MB_CAPABLE
+
+#define ONES    ((uintptr_t) -1 / 0xff)
+#define HIGHS   (ONES << 7)
+
+static size_t
+iconv_unit(enum iconv_kind kind)
+{
+    switch (kind) {
+    case iconv_ucs_2:
+    case iconv_ucs_2_swap:
+        return 2;
+    case iconv_ucs_4:
+    case iconv_ucs_4_swap:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+/*
+ * Count the leading bytes between 0x01 and 0x7f, checking a word at
+ * a time. Such bytes have neither their own top bit set nor borrow
+ * when one is subtracted from them, so a word holding only those
+ * never has any top bit set in (w | (w - ONES)).
+ */
+static size_t
+iconv_ascii_run(const unsigned char *in, size_t max)
+{
+    size_t      n = 0;
+    uintptr_t   w;
+
+    while (n + sizeof(w) <= max) {
+        memcpy(&w, in + n, sizeof(w));
+        if ((w | (w - ONES)) & HIGHS)
+            break;
+        n += sizeof(w);
+    }
+    while (n < max && (unsigned char) (in[n] - 1) < 0x7f)
+        n++;
+    return n;
+}
+
+/* Copy n ASCII bytes to the output encoding */
+static void
+iconv_widen(unsigned char *out, const unsigned char *in, size_t n, enum iconv_kind kind)
+{
+    size_t      i;
+    uint16_t    u16;
+    uint32_t    u32;
+
+    switch (kind) {
+    case iconv_ucs_2:
+        for (i = 0; i < n; i++) {
+            u16 = in[i];
+            memcpy(out + i * 2, &u16, 2);
+        }
+        break;
+    case iconv_ucs_2_swap:
+        for (i = 0; i < n; i++) {
+            u16 = (uint16_t) (in[i] << 8);
+            memcpy(out + i * 2, &u16, 2);
+        }
+        break;
+    case iconv_ucs_4:
+        for (i = 0; i < n; i++) {
+            u32 = in[i];
+            memcpy(out + i * 4, &u32, 4);
+        }
+        break;
+    case iconv_ucs_4_swap:
+        for (i = 0; i < n; i++) {
+            u32 = (uint32_t) in[i] << 24;
+            memcpy(out + i * 4, &u32, 4);
+        }
+        break;
+    default:
+        memcpy(out, in, n);
+        break;
+    }
+}
+
+static uint32_t
+iconv_load(const unsigned char *in, enum iconv_kind kind)
+{
+    uint16_t    u16;
+    uint32_t    u32;
+
+    switch (kind) {
+    case iconv_ucs_2:
+        memcpy(&u16, in, 2);
+        return u16;
+    case iconv_ucs_2_swap:
+        memcpy(&u16, in, 2);
+        return __bswap16(u16);
+    case iconv_ucs_4:
+        memcpy(&u32, in, 4);
+        return u32;
+    default:
+        memcpy(&u32, in, 4);
+        return __bswap32(u32);
+    }
+}
+
+/* Convert leading UCS-2/UCS-4 ASCII characters to bytes */
+static size_t
+iconv_narrow(unsigned char *out, const unsigned char *in, size_t max, enum iconv_kind kind)
+{
+    size_t      unit = iconv_unit(kind);
+    size_t      n;
+    uint32_t    c;
+
+    for (n = 0; n < max; n++) {
+        c = iconv_load(in + n * unit, kind);
+        if (c >= 0x80)
+            break;
+        out[n] = (unsigned char) c;
+    }
+    return n;
+}
+
+/*
+ * Decode one character without calling in_mbtowc. Returns the number
+ * of bytes used, or 0 when the character needs the general path
+ */
+static size_t
+iconv_decode(iconv_t ic, const unsigned char *in, size_t inbytes, wchar_t *wc)
+{
+    unsigned char       c = *in;
+    mbstate_t           state;
+    int                 ret;
+    size_t              unit;
+    uint32_t            u32;
+
+    switch (ic->in_kind) {
+    case iconv_ucs_2:
+    case iconv_ucs_2_swap:
+    case iconv_ucs_4:
+    case iconv_ucs_4_swap:
+        unit = iconv_unit(ic->in_kind);
+        if (inbytes < unit)
+            return 0;
+        u32 = iconv_load(in, ic->in_kind);
+        /* Values beyond Unicode or wchar_t are reported by the general path */
+        if (u32 > 0x10ffff || (uint32_t) (wchar_t) u32 != u32)
+            return 0;
+        *wc = (wchar_t) u32;
+        return unit;
+    default:
+        break;
+    }
+
+    /* NUL ends the input, leave that to the general path */
+    if (c == 0)
+        return 0;
+    if (c < 0x80) {
+        *wc = c;
+        return 1;
+    }
+    switch (ic->in_kind) {
+    case iconv_utf_8:
+        memset(&state, 0, sizeof(state));
+        ret = __utf8_mbtowc(wc, (const char *) in, inbytes, &state);
+        if (ret <= 0 || state.__count != 0)
+            return 0;
+        return (size_t) ret;
+    case iconv_iso_8859_1:
+        *wc = c;
+        return 1;
+    case iconv_iso:
+        *wc = c < 0xa0 ? c : ic->in_conv[c - 0xa0];
+        break;
+    case iconv_cp:
+        *wc = ic->in_conv[c - 0x80];
+        break;
+    default:
+        return 0;
+    }
+    /* Invalid characters are reported by the general path */
+    if (*wc == 0)
+        return 0;
+    return 1;
+}
+
+/*
+ * Encode one character without calling out_wctomb. Returns the number
+ * of bytes stored, or 0 when the character needs the general path
+ */
+static size_t
+iconv_encode(iconv_t ic, unsigned char *out, size_t outbytes, wchar_t _wc)
+{
+    uint32_t    wc = (uint32_t) _wc;
+    size_t      unit = iconv_unit(ic->out_kind);
+    uint16_t    u16;
+
+    if (outbytes < unit)
+        return 0;
+    switch (ic->out_kind) {
+    case iconv_utf_8:
+        if (wc < 0x80) {
+            *out = (unsigned char) wc;
+            return 1;
+        }
+        if (wc < 0x800) {
+            if (outbytes < 2)
+                return 0;
+            out[0] = (unsigned char) (0xc0 | (wc >> 6));
+            out[1] = (unsigned char) (0x80 | (wc & 0x3f));
+            return 2;
+        }
+        if (wc < 0x10000) {
+            if (outbytes < 3 || (0xd800 <= wc && wc <= 0xdfff))
+                return 0;
+            out[0] = (unsigned char) (0xe0 | (wc >> 12));
+            out[1] = (unsigned char) (0x80 | ((wc >> 6) & 0x3f));
+            out[2] = (unsigned char) (0x80 | (wc & 0x3f));
+            return 3;
+        }
+        if (outbytes < 4 || wc > 0x10ffff)
+            return 0;
+        out[0] = (unsigned char) (0xf0 | (wc >> 18));
+        out[1] = (unsigned char) (0x80 | ((wc >> 12) & 0x3f));
+        out[2] = (unsigned char) (0x80 | ((wc >> 6) & 0x3f));
+        out[3] = (unsigned char) (0x80 | (wc & 0x3f));
+        return 4;
+    case iconv_iso_8859_1:
+        if (wc >= 0x100)
+            return 0;
+        *out = (unsigned char) wc;
+        return 1;
+    case iconv_iso:
+        if (wc >= 0xa0)
+            return 0;
+        *out = (unsigned char) wc;
+        return 1;
+    case iconv_ucs_2:
+    case iconv_ucs_2_swap:
+        if (wc > 0xffff || (0xd800 <= wc && wc <= 0xdfff))
+            return 0;
+        u16 = (uint16_t) wc;
+        if (ic->out_kind == iconv_ucs_2_swap)
+            u16 = __bswap16(u16);
+        memcpy(out, &u16, 2);
+        return 2;
+    case iconv_ucs_4:
+    case iconv_ucs_4_swap:
+        if (wc > 0x10ffff || (0xd800 <= wc && wc <= 0xdfff))
+            return 0;
+        if (ic->out_kind == iconv_ucs_4_swap)
+            wc = __bswap32(wc);
+        memcpy(out, &wc, 4);
+        return 4;
+    default:
+        if (wc >= 0x80)
+            return 0;
+        *out = (unsigned char) wc;
+        return 1;
+    }
+}
+
+/*
+ * Convert as much input as possible without the per-character
+ * functions, copying runs of ASCII characters in bulk. This stops at
+ * anything which needs the general path: NUL bytes, invalid or
+ * incomplete input, characters without a direct conversion and
+ * output which doesn't fit. Returns whether any input was consumed.
+ */
+static bool
+iconv_fast(iconv_t ic, char **inp, size_t *inbytesp, char **outp, size_t *outbytesp)
+{
+    const unsigned char *in = (const unsigned char *) *inp;
+    unsigned char       *out = (unsigned char *) *outp;
+    size_t              inbytes = *inbytesp;
+    size_t              outbytes = *outbytesp;
+    size_t              in_unit = iconv_unit(ic->in_kind);
+    size_t              out_unit = iconv_unit(ic->out_kind);
+    size_t              run, max, in_len, out_len;
+    wchar_t             wc;
+
+    for (;;) {
+        max = inbytes / in_unit;
+        if (max > outbytes / out_unit)
+            max = outbytes / out_unit;
+        run = 0;
+        if (in_unit == 1) {
+            run = iconv_ascii_run(in, max);
+            iconv_widen(out, in, run, ic->out_kind);
+        } else if (out_unit == 1) {
+            run = iconv_narrow(out, in, max, ic->in_kind);
+        }
+        in += run * in_unit;
+        inbytes -= run * in_unit;
+        out += run * out_unit;
+        outbytes -= run * out_unit;
+
+        if (!inbytes)
+            break;
+        in_len = iconv_decode(ic, in, inbytes, &wc);
+        if (!in_len)
+            break;
+        out_len = iconv_encode(ic, out, outbytes, wc);
+        if (!out_len)
+            break;
+        in += in_len;
+        inbytes -= in_len;
+        out += out_len;
+        outbytes -= out_len;
+    }
+    if (in == (const unsigned char *) *inp)
+        return false;
+    *inp = (char *) in;
+    *inbytesp = inbytes;
+    *outp = (char *) out;
+    *outbytesp = outbytes;
+    return true;
+}
+
+#endif
 
 size_t
 iconv (iconv_t ic,
@@ -55,50 +375,63 @@ iconv (iconv_t ic,
     size_t      tocopy;
 #ifdef __MB_CAPABLE
     int         ret;
+    size_t      used;
     wchar_t     wc;
+    mbstate_t   in_state;
     size_t      char_count = 0;
 
     for (;;) {
         if (outbytes && ic->buf_len) {
-            tocopy = ic->buf_len;
+            tocopy = ic->buf_len - ic->buf_off;
             if (tocopy > outbytes)
                 tocopy = outbytes;
             memcpy(out, ic->buf + ic->buf_off, tocopy);
             out += tocopy;
+            outbytes -= tocopy;
             ic->buf_off += tocopy;
             if (ic->buf_off == ic->buf_len) {
                 char_count++;
                 ic->buf_off = ic->buf_len = 0;
             }
         } else if (inbytes && ic->buf_len == 0) {
+            if (ic->in_kind != iconv_other && ic->out_kind != iconv_other &&
+                ic->in_state.__count == 0 && ic->out_state.__count == 0 &&
+                iconv_fast(ic, &in, &inbytes, &out, &outbytes))
+                continue;
+            /* Leave the input alone if the character can't be converted */
+            in_state = ic->in_state;
             ret = ic->in_mbtowc(&wc, in, inbytes, &ic->in_state);
             switch (ret) {
             case 0:
                 wc = L'\0';
-                in += inbytes;
-                inbytes = 0;
+                used = inbytes;
                 break;
             case -1:
                 goto fail;
             case -2:
                 goto done;
             default:
-                in += ret;
-                inbytes -= ret;
+                used = ret;
                 break;
             }
             if (outbytes >= MB_LEN_MAX) {
                 ret = ic->out_wctomb(out, wc, &ic->out_state);
-                if (ret == -1)
+                if (ret == -1) {
+                    ic->in_state = in_state;
                     goto fail;
+                }
                 out += ret;
                 outbytes -= ret;
             } else {
                 ret = ic->out_wctomb(ic->buf, wc, &ic->out_state);
-                if (ret == -1)
+                if (ret == -1) {
+                    ic->in_state = in_state;
                     goto fail;
+                }
                 ic->buf_len = ret;
             }
+            in += used;
+            inbytes -= used;
         } else {
             break;
         }
@@ -112,13 +445,15 @@ done:
 fail:
     *inbuf = in;
     *inbytesleft = inbytes;
+    *outbuf = out;
+    *outbytesleft = outbytes;
     errno = EILSEQ;
     return (size_t) -1;
 #else
     (void) ic;
 
     tocopy = inbytes;
-    if (tocopy < outbytes)
+    if (tocopy > outbytes)
         tocopy = outbytes;
     memcpy(out, in, tocopy);
     in += tocopy;
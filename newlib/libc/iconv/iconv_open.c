@@ -36,6 +36,68 @@
 #define _DEFAULT_SOURCE
 #include "iconv_private.h"
 
+#ifdef __MB_CAPABLE
+/*
+ * Find how iconv can convert an encoding directly. For tables
+ * mapping bytes to wchar_t, *conv is set to point at the table.
+ */
+static enum iconv_kind
+charset_kind(enum locale_id id, const uint16_t **conv)
+{
+    (void) conv;
+    switch (id) {
+    case locale_C:
+        return iconv_ascii;
+    case locale_UTF_8:
+        return iconv_utf_8;
+#ifdef __MB_EXTENDED_CHARSETS_UCS
+#if _BYTE_ORDER == _LITTLE_ENDIAN
+    case locale_UCS_2:
+    case locale_UCS_2LE:
+        return iconv_ucs_2;
+    case locale_UCS_2BE:
+        return iconv_ucs_2_swap;
+    case locale_UCS_4:
+    case locale_UCS_4LE:
+        return iconv_ucs_4;
+    case locale_UCS_4BE:
+        return iconv_ucs_4_swap;
+#else
+    case locale_UCS_2:
+    case locale_UCS_2BE:
+        return iconv_ucs_2;
+    case locale_UCS_2LE:
+        return iconv_ucs_2_swap;
+    case locale_UCS_4:
+    case locale_UCS_4BE:
+        return iconv_ucs_4;
+    case locale_UCS_4LE:
+        return iconv_ucs_4_swap;
+#endif
+#endif
+    default:
+        break;
+    }
+#ifdef __MB_EXTENDED_CHARSETS_ISO
+    if (id == locale_ISO_8859_1)
+        return iconv_iso_8859_1;
+    if (locale_ISO_8859_2 <= id && id <= locale_ISO_8859_16) {
+        if (conv)
+            *conv = __iso_8859_conv[id - locale_ISO_8859_2];
+        return iconv_iso;
+    }
+#endif
+#ifdef __MB_EXTENDED_CHARSETS_WINDOWS
+    if (locale_WINDOWS_BASE <= id && id <= locale_KOI8_T) {
+        if (conv)
+            *conv = __cp_conv[id - locale_WINDOWS_BASE];
+        return iconv_cp;
+    }
+#endif
+    return iconv_other;
+}
+#endif
+
 iconv_t
 iconv_open (const char *tocode, const char *fromcode)
 {
@@ -57,6 +119,8 @@ iconv_open (const char *tocode, const char *fromcode)
 
     ic->in_mbtowc = __get_mbtowc(fromid);
     ic->out_wctomb = __get_wctomb(toid);
+    ic->in_kind = charset_kind(fromid, &ic->in_conv);
+    ic->out_kind = charset_kind(toid, NULL);
     return ic;
 #else
     return NULL;
@@ -40,9 +40,30 @@
 #include "../ctype/ctype_.h"
 #include <iconv.h>
 
+/*
+ * Encodings which iconv can convert without going through the
+ * per-character mbtowc/wctomb functions. All of the byte encodings
+ * map 0x01 through 0x7f to ASCII
+ */
+enum iconv_kind {
+    iconv_other,        /* only the general path */
+    iconv_ascii,        /* ASCII, other bytes use the general path */
+    iconv_utf_8,
+    iconv_iso_8859_1,
+    iconv_iso,          /* ISO 8859 with a conversion table */
+    iconv_cp,           /* Windows code page with a conversion table */
+    iconv_ucs_2,
+    iconv_ucs_2_swap,
+    iconv_ucs_4,
+    iconv_ucs_4_swap,
+};
+
 struct __iconv_t {
     mbtowc_p    in_mbtowc;
     wctomb_p    out_wctomb;
+    enum iconv_kind in_kind;
+    enum iconv_kind out_kind;
+    const uint16_t *in_conv;
     mbstate_t   in_state;
     mbstate_t   out_state;
     char        buf[MB_LEN_MAX];
@@ -37,4 +37,7 @@ SUCH DAMAGE.
 #define ENV_LOCK __LIBC_LOCK()
 #define ENV_UNLOCK __LIBC_UNLOCK()
 
+/* Changed by setenv and unsetenv so that cached values can be checked */
+extern unsigned int __env_generation;
+
 #endif /* _INCLUDE_ENVLOCK_H_ */
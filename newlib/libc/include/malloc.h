@@ -71,7 +71,31 @@ void	*realloc(void *, size_t) __warn_unused_result __alloc_size(2) __nothrow;
 void    *memalign (size_t __alignment, size_t __size)  __malloc_like
     __warn_unused_result __alloc_size(2) __nothrow;
 
+/* Detailed heap statistics, only provided by the nano malloc. The
+   call counts, size histogram and walk lengths are only recorded
+   when it is built with __NANO_MALLOC_INSTRUMENT.  */
+
+#define MALLOC_HISTOGRAM_BINS 16
+
+struct malloc_instrument {
+  size_t free_chunks;     /* number of chunks in the free lists */
+  size_t free_bytes;      /* total size of those chunks */
+  size_t largest_free;    /* size of the largest free chunk */
+  size_t fragmentation;   /* free space outside the largest chunk, per mille */
+  size_t alloc_calls;     /* number of allocations */
+  size_t alloc_failures;  /* allocations which returned NULL */
+  size_t free_calls;      /* number of frees */
+  size_t size_histogram[MALLOC_HISTOGRAM_BINS];
+                          /* allocations by requested size. bin n
+                             counts sizes below 16 << n, the last bin
+                             counts the rest */
+  size_t walk_total;      /* free chunks inspected by all allocations */
+  size_t walk_max;        /* most free chunks inspected by one allocation */
+};
+
 struct mallinfo mallinfo (void);
+int malloc_instrument (struct malloc_instrument *);
+void malloc_instrument_reset (void);
 void malloc_stats (void);
 int mallopt (int, int);
 size_t malloc_usable_size (void *);
@@ -83,6 +107,11 @@ int malloc_trim (size_t);
 void __malloc_lock(void);
 void __malloc_unlock(void);
 
+/* Return memory held by the calling thread back to the heap. Only
+   provided by the nano malloc, where the thread cache needs it;
+   multi-threaded systems should call it as each thread exits.  */
+void __malloc_thread_exit(void);
+
 /* SVID2/XPG mallopt options */
 
 #define M_MXFAST  1    /* UNUSED in this malloc */
@@ -100,6 +129,25 @@ void __malloc_unlock(void);
 /* Some systems provide this, so do too for compatibility.  */
 void cfree (void *);
 
+/* Arena allocator. Allocations are carved in order from a single
+   block of storage and are all released together by
+   malloc_arena_reset or malloc_arena_destroy.  */
+
+struct malloc_arena {
+  char *base;      /* start of storage */
+  char *pos;       /* next unallocated byte */
+  char *end;       /* end of storage */
+  int alloc;       /* storage came from malloc */
+};
+
+int malloc_arena_init (struct malloc_arena *, void *, size_t);
+void *malloc_arena_alloc (struct malloc_arena *, size_t) __malloc_like
+    __warn_unused_result __alloc_size(2) __nothrow;
+void *malloc_arena_realloc (struct malloc_arena *, void *, size_t, size_t)
+    __warn_unused_result __alloc_size(4) __nothrow;
+void malloc_arena_reset (struct malloc_arena *);
+void malloc_arena_destroy (struct malloc_arena *);
+
 _END_STD_C
 
 #endif /* _INCLUDE_MALLOC_H_ */
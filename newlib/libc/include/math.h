@@ -111,6 +111,20 @@ _BEGIN_STD_C
 
 #endif /* !gcc >= 3.3  */
 
+/*
+ * Vector versions of expf, logf, sinf, cosf and powf are provided for
+ * x86_64 using the GCC vector function ABI. Declaring them lets the
+ * compiler vectorize loops calling these functions. This is skipped
+ * within the library as GCC would otherwise generate its own vector
+ * versions from the scalar function definitions.
+ */
+#if !defined(_LIBC) && !__OBSOLETE_MATH_FLOAT && __GNUC_PREREQ (9, 0) && \
+    __has_attribute(__simd__) && defined(__x86_64__) && defined(__SSE2__)
+#define __declare_simd __attribute__((__simd__("notinbranch")))
+#else
+#define __declare_simd
+#endif
+
 extern double atan (double);
 extern double cos (double);
 extern double sin (double);
@@ -492,8 +506,8 @@ extern double hypot (double, double);
 /* Single precision versions of ANSI functions.  */
 
 extern float atanf (float);
-extern float cosf (float);
-extern float sinf (float);
+extern float cosf (float) __declare_simd;
+extern float sinf (float) __declare_simd;
 extern float tanf (float);
 extern float tanhf (float);
 extern float frexpf (float, int *);
@@ -507,11 +521,11 @@ extern float asinf (float);
 extern float atan2f (float, float);
 extern float coshf (float);
 extern float sinhf (float);
-extern float expf (float);
+extern float expf (float) __declare_simd;
 extern float ldexpf (float, int);
-extern float logf (float);
+extern float logf (float) __declare_simd;
 extern float log10f (float);
-extern float powf (float, float);
+extern float powf (float, float) __declare_simd;
 extern float sqrtf (float);
 extern float fmodf (float, float);
 
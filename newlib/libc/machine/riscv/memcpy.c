@@ -11,7 +11,7 @@
 
 #include <picolibc.h>
 
-#if defined(__PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+#if defined(__PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__) || defined(__riscv_vector)
 //memcpy defined in memcpy-asm.S
 #else
 
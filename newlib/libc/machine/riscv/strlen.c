@@ -11,6 +11,10 @@
 
 #include <picolibc.h>
 
+#if defined(__riscv_vector)
+//strlen defined in strlen-asm.S
+#else
+
 #include <string.h>
 #include <stdint.h>
 #include "rv_string.h"
@@ -55,3 +59,5 @@ size_t strlen(const char *str)
     return str - start;
 #endif /* not PREFER_SIZE_OVER_SPEED */
 }
+
+#endif
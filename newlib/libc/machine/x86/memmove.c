@@ -1,5 +1,6 @@
 #include <picolibc.h>
 
-#ifdef __x86_64
+/* memcpy-64.S provides memmove when SSE2 is available */
+#if defined(__x86_64) && !defined(__SSE2__)
 #include "../../string/memmove.c"
 #endif
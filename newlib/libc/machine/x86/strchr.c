@@ -1,5 +1,5 @@
 #include <picolibc.h>
 
-#ifdef __x86_64
+#if defined(__x86_64) && !defined(__SSE2__)
 #include "../../string/strchr.c"
 #endif
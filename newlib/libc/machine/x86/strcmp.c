@@ -0,0 +1,5 @@
+#include <picolibc.h>
+
+#if !defined(__x86_64) || !defined(__SSE2__)
+#include "../../string/strcmp.c"
+#endif
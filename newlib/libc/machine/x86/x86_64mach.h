@@ -47,6 +47,12 @@ is preserved.
 #define r14 REG(r14)
 #define r15 REG(r15)
 
+#define r8d REG(r8d)
+#define r8w REG(r8w)
+#define r9d REG(r9d)
+#define r10d REG(r10d)
+#define r11d REG(r11d)
+
 #define eax REG(eax)
 #define ebx REG(ebx)
 #define ecx REG(ecx)
@@ -98,6 +104,31 @@ is preserved.
 #define xmm5 REG(xmm5)
 #define xmm6 REG(xmm6)
 #define xmm7 REG(xmm7)
+#define xmm8 REG(xmm8)
+#define xmm9 REG(xmm9)
+#define xmm10 REG(xmm10)
+#define xmm11 REG(xmm11)
+#define xmm12 REG(xmm12)
+#define xmm13 REG(xmm13)
+#define xmm14 REG(xmm14)
+#define xmm15 REG(xmm15)
+
+#define ymm0 REG(ymm0)
+#define ymm1 REG(ymm1)
+#define ymm2 REG(ymm2)
+#define ymm3 REG(ymm3)
+#define ymm4 REG(ymm4)
+#define ymm5 REG(ymm5)
+#define ymm6 REG(ymm6)
+#define ymm7 REG(ymm7)
+#define ymm8 REG(ymm8)
+#define ymm9 REG(ymm9)
+#define ymm10 REG(ymm10)
+#define ymm11 REG(ymm11)
+#define ymm12 REG(ymm12)
+#define ymm13 REG(ymm13)
+#define ymm14 REG(ymm14)
+#define ymm15 REG(ymm15)
 
 #define cr0 REG(cr0)
 #define cr1 REG(cr1)
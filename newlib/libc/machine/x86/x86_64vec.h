@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Vector helpers for the x86_64 string functions. These use 32-byte
+ * AVX2 registers when the compiler targets AVX2 (-mavx2 or
+ * -march=x86-64-v3) and 16-byte SSE2 registers otherwise. Operations
+ * are written as (src, dst) with dst = dst op src to match the
+ * two-operand SSE2 forms.
+ */
+
+#ifndef _X86_64VEC_H_
+#define _X86_64VEC_H_
+
+#include "x86_64mach.h"
+
+#ifdef __AVX2__
+
+#define VEC_SIZE        32
+#define VEC_MASK_ALL    0xffffffff
+#define VEC(n)          ymm##n
+
+#define VMOVU           vmovdqu
+#define VMOVA           vmovdqa
+#define VPMOVMSKB       vpmovmskb
+#define VPCMPEQB(s, d)  vpcmpeqb s, d, d
+#define VPMINUB(s, d)   vpminub s, d, d
+#define VPOR(s, d)      vpor s, d, d
+#define VPXOR(s, d)     vpxor s, d, d
+#define VZEROUPPER      vzeroupper
+
+/* Replicate the low byte of a 32-bit register across VEC(n) */
+#define VBROADCASTB(r, n)                               \
+        vmovd r, xmm##n;                                \
+        vpbroadcastb xmm##n, ymm##n
+
+#else
+
+#define VEC_SIZE        16
+#define VEC_MASK_ALL    0xffff
+#define VEC(n)          xmm##n
+
+#define VMOVU           movdqu
+#define VMOVA           movdqa
+#define VPMOVMSKB       pmovmskb
+#define VPCMPEQB(s, d)  pcmpeqb s, d
+#define VPMINUB(s, d)   pminub s, d
+#define VPOR(s, d)      por s, d
+#define VPXOR(s, d)     pxor s, d
+#define VZEROUPPER
+
+#define VBROADCASTB(r, n)                               \
+        movd r, xmm##n;                                 \
+        punpcklbw xmm##n, xmm##n;                       \
+        pshuflw $0, xmm##n, xmm##n;                     \
+        pshufd $0, xmm##n, xmm##n
+
+#endif
+
+#endif /* _X86_64VEC_H_ */
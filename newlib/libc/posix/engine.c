@@ -48,6 +48,10 @@
 #define	dissect	sdissect
 #define	backref	sbackref
 #define	step	sstep
+#define	dfast	sdfast
+#define	dflags	sdflags
+#define	dstate	sdstate
+#define	dstart	sdstart
 #define	print	sprint
 #define	at	sat
 #define	match	smat
@@ -59,6 +63,10 @@
 #define	dissect	ldissect
 #define	backref	lbackref
 #define	step	lstep
+#define	dfast	ldfast
+#define	dflags	ldflags
+#define	dstate	ldstate
+#define	dstart	ldstart
 #define	print	lprint
 #define	at	lat
 #define	match	lmat
@@ -90,6 +98,10 @@ static char *backref(struct match *m, char *start, char *stop, sopno startst, so
 static char *fast(struct match *m, char *start, char *stop, sopno startst, sopno stopst);
 static char *slow(struct match *m, char *start, char *stop, sopno startst, sopno stopst);
 static states step(struct re_guts *g, sopno start, sopno stop, states bef, int ch, states aft);
+static int dfast(struct match *m, struct re_dfa *d, char *start, char *stop, sopno startst, sopno stopst, states fresh, states *stp, char **pp, char **coldpp);
+static states dflags(struct match *m, sopno startst, sopno stopst, states st, int kind, int ch);
+static int dstate(struct match *m, struct re_dfa *d, states st, int kind, states fresh);
+static int dstart(struct match *m, struct re_dfa *d, int kind, states fresh);
 #define	BOL	(OUT+1)
 #define	EOL	(BOL+1)
 #define	BOLEOL	(BOL+2)
@@ -199,12 +211,8 @@ matcher(
 			if (pp != mustfirst)
 				return(REG_NOMATCH);
 		} else {
-			for (dp = start; dp < stop; dp++)
-				if (*dp == g->must[0] &&
-				    stop - dp >= g->mlen &&
-				    memcmp(dp, g->must, (size_t)g->mlen) == 0)
-					break;
-			if (dp == stop)		/* we didn't find g->must */
+			dp = litfind(start, stop, g->must, g->mlen);
+			if (dp == NULL)		/* we didn't find g->must */
 				return(REG_NOMATCH);
 		}
 	}
@@ -228,6 +236,15 @@ matcher(
 	if (g->moffset > -1)
 		start = ((dp - g->moffset) < start) ? start : dp - g->moffset;
 
+	/* No match can start before the first copy of the prefix */
+	if (g->prefix != NULL) {
+		start = litfind(start, stop, g->prefix, g->plen);
+		if (start == NULL) {
+			STATETEARDOWN(m);
+			return(REG_NOMATCH);
+		}
+	}
+
 	/* this loop does only one repetition except for backrefs */
 	for (;;) {
 		endp = fast(m, start, stop, gf, gl);
@@ -242,6 +259,10 @@ matcher(
 		assert(m->coldp != NULL);
 		for (;;) {
 			NOTE("finding start");
+			if (g->prefix != NULL) {
+				m->coldp = litfind(m->coldp, stop, g->prefix, g->plen);
+				assert(m->coldp != NULL);
+			}
 			endp = slow(m, m->coldp, stop, gf, gl);
 			if (endp != NULL)
 				break;
@@ -754,6 +775,7 @@ fast(
 	int flagch;
 	int i;
 	char *coldp;		/* last p after which no match was underway */
+	struct re_dfa *d;
 
 	CLEAR(st);
 	SET1(st, startst);
@@ -761,6 +783,18 @@ fast(
 	ASSIGN(fresh, st);
 	SP("start", st, *p);
 	coldp = NULL;
+	d = dfaclaim(m->g, STATEBYTES);
+	if (d != NULL) {
+		i = dfast(m, d, start, stop, startst, stopst, fresh, &st,
+			  &p, &coldp);
+		dfarelease(d);
+		if (i != DFA_GIVEUP) {
+			m->coldp = coldp;
+			return((i == DFA_MATCH) ? p+1 : NULL);
+		}
+		/* the cache thrashed; carry on from where it stopped */
+		c = (p == m->beginp) ? OUT : *(p-1);
+	}
 	for (;;) {
 		/* next character */
 		lastc = c;
@@ -823,6 +857,218 @@ fast(
 		return(NULL);
 }
 
+/*
+ - dfast - fast() using the lazy DFA
+ == static int dfast(struct match *m, struct re_dfa *d, char *start, \
+ ==	char *stop, sopno startst, sopno stopst, states fresh, \
+ ==	states *stp, char **pp, char **coldpp);
+ *
+ * Finds the same answer as fast(), leaving the end position in *pp
+ * and the coldp value in *coldpp.  When giving up, *pp and *stp
+ * hold the position and states from which fast() should continue.
+ */
+static int			/* DFA_MATCH, DFA_NOMATCH or DFA_GIVEUP */
+dfast(
+	struct match *m,
+	struct re_dfa *d,
+	char *start,
+	char *stop,
+	sopno startst,
+	sopno stopst,
+	states fresh,
+	states *stp,
+	char **pp,
+	char **coldpp
+)
+{
+	states st = *stp;
+	states tmp = m->tmp;
+	char *p = start;
+	char *coldp = NULL;
+	char *flushp = start;	/* where the cache was last emptied */
+	short *next;
+	int kind;
+	int s;
+	int t;
+
+	if (start == m->beginp)
+		kind = (m->eflags&REG_NOTBOL) ? DFA_CTX_NOTBOL : DFA_CTX_BOL;
+	else
+		kind = d->ctxs[(uch)*(start-1)];
+	s = dstart(m, d, kind, fresh);
+
+	for (; p != stop; p++) {
+		if (d->fresh[s] && m->g->prefix != NULL &&
+		    *p != m->g->prefix[0]) {
+			/* skip to where the next match could begin */
+			p = litfind(p, stop, m->g->prefix, m->g->plen);
+			if (p == NULL) {
+				*pp = stop;
+				*coldpp = coldp;
+				return(DFA_NOMATCH);
+			}
+			s = dstart(m, d, d->ctxs[(uch)*(p-1)], fresh);
+		}
+		if (d->fresh[s])
+			coldp = p;
+		next = &d->next[s * d->nclasses + d->classes[(uch)*p]];
+		t = *next;
+		if (t == DFA_UNKNOWN) {
+			LOADSTATES(st, &d->sets[s * d->setsize]);
+			st = dflags(m, startst, stopst, st, d->kinds[s], *p);
+			if (ISSET(st, stopst)) {
+				t = DFA_ACCEPT;
+			} else {
+				ASSIGN(tmp, st);
+				ASSIGN(st, fresh);
+				st = step(m->g, startst, stopst, tmp, *p, st);
+				kind = d->ctxs[(uch)*p];
+				t = dstate(m, d, st, kind, fresh);
+				if (t == DFA_UNKNOWN) {
+					/* the cache is full */
+					if (p - flushp < DFA_MINRUN * d->maxstates) {
+						LOADSTATES(st, &d->sets[s * d->setsize]);
+						*stp = st;
+						*pp = p;
+						*coldpp = coldp;
+						return(DFA_GIVEUP);
+					}
+					flushp = p;
+					dfaflush(d);
+					s = dstate(m, d, st, kind, fresh);
+					continue;
+				}
+			}
+			*next = (short)t;
+		}
+		if (t == DFA_ACCEPT)
+			break;
+		s = t;
+	}
+
+	if (p == stop) {
+		if (d->fresh[s])
+			coldp = p;
+		LOADSTATES(st, &d->sets[s * d->setsize]);
+		st = dflags(m, startst, stopst, st, d->kinds[s],
+			    (p == m->endp) ? OUT : *p);
+	}
+	*stp = st;
+	*pp = p;
+	*coldpp = coldp;
+	return((p != stop || ISSET(st, stopst)) ? DFA_MATCH : DFA_NOMATCH);
+}
+
+/*
+ - dstart - find the DFA state for starting a match
+ == static int dstart(struct match *m, struct re_dfa *d, int kind, \
+ ==	states fresh);
+ */
+static int
+dstart(
+	struct match *m,
+	struct re_dfa *d,
+	int kind,			/* kind of preceding character */
+	states fresh
+)
+{
+	int s = d->start[kind];
+
+	if (s == DFA_UNKNOWN) {
+		s = dstate(m, d, fresh, kind, fresh);
+		if (s == DFA_UNKNOWN) {
+			dfaflush(d);
+			s = dstate(m, d, fresh, kind, fresh);
+		}
+		d->start[kind] = (short)s;
+	}
+	return(s);
+}
+
+/*
+ - dflags - apply the ^, $ and word boundaries between two characters
+ == static states dflags(struct match *m, sopno startst, sopno stopst, \
+ ==	states st, int kind, int ch);
+ *
+ * This is the flag handling from fast(), with the preceding character
+ * described by its DFA_CTX_ kind.
+ */
+static states
+dflags(
+	struct match *m,
+	sopno startst,
+	sopno stopst,
+	states st,
+	int kind,			/* kind of preceding character */
+	int ch				/* next character, or OUT */
+)
+{
+	int flagch = '\0';
+	int i = 0;
+
+	if (kind == DFA_CTX_BOL || kind == DFA_CTX_NEWLINE) {
+		flagch = BOL;
+		i = m->g->nbol;
+	}
+	if ( (ch == '\n' && m->g->cflags&REG_NEWLINE) ||
+			(ch == OUT && !(m->eflags&REG_NOTEOL)) ) {
+		flagch = (flagch == BOL) ? BOLEOL : EOL;
+		i += m->g->neol;
+	}
+	for (; i > 0; i--)
+		st = step(m->g, startst, stopst, st, flagch, st);
+
+	if ( (flagch == BOL || kind == DFA_CTX_NEWLINE ||
+	      kind == DFA_CTX_OTHER) && (ch != OUT && ISWORD(ch)) )
+		flagch = BOW;
+	if ( kind == DFA_CTX_WORD &&
+			(flagch == EOL || (ch != OUT && !ISWORD(ch))) )
+		flagch = EOW;
+	if (flagch == BOW || flagch == EOW)
+		st = step(m->g, startst, stopst, st, flagch, st);
+	return(st);
+}
+
+/*
+ - dstate - find or add the DFA state for a set of states
+ == static int dstate(struct match *m, struct re_dfa *d, states st, \
+ ==	int kind, states fresh);
+ */
+static int			/* state, or DFA_UNKNOWN if the cache is full */
+dstate(
+	struct match *m,
+	struct re_dfa *d,
+	states st,
+	int kind,
+	states fresh
+)
+{
+	uch *set = &d->sets[d->maxstates * d->setsize];
+	unsigned hash = 2166136261U;
+	size_t i;
+	int s;
+
+	(void) m;
+	SAVESTATES(set, st);
+	for (i = 0; i < d->setsize; i++)
+		hash = (hash ^ set[i]) * 16777619U;
+	for (s = 0; s < d->nstates; s++)
+		if (d->hashes[s] == hash && d->kinds[s] == kind &&
+		    memcmp(&d->sets[s * d->setsize], set, d->setsize) == 0)
+			return(s);
+	if (d->nstates == d->maxstates)
+		return(DFA_UNKNOWN);
+
+	s = d->nstates++;
+	memcpy(&d->sets[s * d->setsize], set, d->setsize);
+	d->hashes[s] = hash;
+	d->kinds[s] = (uch)kind;
+	d->fresh[s] = EQ(st, fresh);
+	for (i = 0; i < (size_t)d->nclasses; i++)
+		d->next[s * d->nclasses + i] = DFA_UNKNOWN;
+	return(s);
+}
+
 /*
  - slow - step through the string more deliberately
  == static char *slow(struct match *m, char *start, \
@@ -1129,6 +1375,10 @@ pchar(int ch)
 #undef	dissect
 #undef	backref
 #undef	step
+#undef	dfast
+#undef	dflags
+#undef	dstate
+#undef	dstart
 #undef	print
 #undef	at
 #undef	match
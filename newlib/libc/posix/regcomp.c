@@ -118,10 +118,12 @@ static void dofwd(struct parse *p, sopno pos, sop value);
 static void enlarge(struct parse *p, sopno size);
 static void stripsnug(struct parse *p, struct re_guts *g);
 static void findmust(struct parse *p, struct re_guts *g);
+static void findprefix(struct parse *p, struct re_guts *g);
 static int altoffset(sop *scan, int offset, int mccs);
 static void computejumps(struct parse *p, struct re_guts *g);
 static void computematchjumps(struct parse *p, struct re_guts *g);
 static sopno pluscount(struct parse *p, struct re_guts *g);
+static void dfainit(struct parse *p, struct re_guts *g);
 
 /* ========= end header generated by ./mkh ========= */
 
@@ -235,6 +237,8 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 	g->neol = 0;
 	g->must = NULL;
 	g->moffset = -1;
+	g->prefix = NULL;
+	g->plen = 0;
 	g->charjump = NULL;
 	g->matchjump = NULL;
 	g->mlen = 0;
@@ -243,6 +247,7 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 	g->categories = &g->catspace[-(CHAR_MIN)];
 	(void) memset((char *)g->catspace, 0, NC*sizeof(cat_t));
 	g->backrefs = 0;
+	g->dfa = NULL;
 
 	/* do it */
 	EMIT(OEND, 0);
@@ -260,6 +265,7 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 	categorize(p, g);
 	stripsnug(p, g);
 	findmust(p, g);
+	findprefix(p, g);
 	/* only use Boyer-Moore algorithm if the pattern is bigger
 	 * than three characters
 	 */
@@ -272,6 +278,7 @@ regcomp(regex_t *__restrict preg, const char *__restrict pattern, int cflags)
 		}
 	}
 	g->nplus = pluscount(p, g);
+	dfainit(p, g);
 	g->magic = MAGIC2;
 	preg->re_nsub = g->nsub;
 	preg->re_g = g;
@@ -1853,6 +1860,50 @@ findmust(
 	*cp++ = '\0';		/* just on general principles */
 }
 
+/*
+ - findprefix - find the literal string every match starts with
+ == static void findprefix(struct parse *p, struct re_guts *g);
+ *
+ * This is the run of plain characters at the front of the strip,
+ * ignoring parentheses and anchors as they don't consume anything.
+ * regexec() uses it to skip over places where no match can start.
+ */
+static void
+findprefix(
+	struct parse *p,
+	struct re_guts *g
+)
+{
+	sop *scan;
+	sop s;
+	int len = 0;
+
+	/* avoid making error situations worse */
+	if (p->error != 0)
+		return;
+
+	for (scan = g->strip + 1; ; scan++) {
+		s = *scan;
+		if (OP(s) == OCHAR)
+			len++;
+		else if (OP(s) != OLPAREN && OP(s) != ORPAREN &&
+			 OP(s) != OBOL && OP(s) != OEOL &&
+			 OP(s) != OBOW && OP(s) != OEOW)
+			break;
+	}
+	if (len == 0)
+		return;
+
+	g->prefix = malloc((size_t)len);
+	if (g->prefix == NULL)
+		return;		/* not fatal, regexec() just works harder */
+	g->plen = len;
+	len = 0;
+	for (scan = g->strip + 1; len < g->plen; scan++)
+		if (OP(*scan) == OCHAR)
+			g->prefix[len++] = (char)OPND(*scan);
+}
+
 /*
  - altoffset - choose biggest offset among multiple choices
  == static int altoffset(sop *scan, int offset, int mccs);
@@ -2098,3 +2149,72 @@ pluscount(
 		g->iflags |= BAD;
 	return(maxnest);
 }
+
+/*
+ - dfainit - set up the lazy DFA, if this pattern can use one
+ == static void dfainit(struct parse *p, struct re_guts *g);
+ *
+ * Characters are put in the same class when they share a category
+ * and are alike as far as word boundaries and REG_NEWLINE are
+ * concerned.  The state tables themselves are allocated by regexec()
+ * the first time they are needed.
+ */
+static void
+dfainit(
+	struct parse *p,
+	struct re_guts *g
+)
+{
+	struct re_dfa *d;
+	short map[NC * 3];	/* class of each category and kind */
+	size_t setsize;
+	size_t per_state;
+	int c;
+	int ctx;
+	int key;
+	int k;
+
+	if (p->error != 0 || g->backrefs || g->ncategories > NC)
+		return;
+
+	d = (struct re_dfa *)malloc(sizeof(struct re_dfa));
+	if (d == NULL)
+		return;		/* not fatal, regexec() just works harder */
+
+	for (k = 0; k < NC * 3; k++)
+		map[k] = -1;
+	d->nclasses = 0;
+	for (c = CHAR_MIN; c <= CHAR_MAX; c++) {
+		if (c == '\n' && (g->cflags&REG_NEWLINE))
+			ctx = DFA_CTX_NEWLINE;
+		else if (ISWORD(c))
+			ctx = DFA_CTX_WORD;
+		else
+			ctx = DFA_CTX_OTHER;
+		key = g->categories[c] * 3 + ctx - DFA_CTX_NEWLINE;
+		if (map[key] < 0)
+			map[key] = (short)d->nclasses++;
+		d->classes[(uch)c] = (uch)map[key];
+		d->ctxs[(uch)c] = (uch)ctx;
+	}
+
+	/* regexec() uses a bit per state when they fit in a long */
+	if (g->nstates <= (sopno)(CHAR_BIT*sizeof(long)))
+		setsize = sizeof(long);
+	else
+		setsize = (size_t)g->nstates;
+	per_state = setsize + sizeof(unsigned) + 2 +
+		(size_t)d->nclasses * sizeof(short);
+	d->maxstates = DFA_MEMORY / per_state;
+	if (d->maxstates > DFA_MAXSTATES)
+		d->maxstates = DFA_MAXSTATES;
+	if (d->maxstates < DFA_MINSTATES) {
+		free(d);
+		return;
+	}
+	d->setsize = setsize;
+	d->nstates = 0;
+	d->busy = 0;
+	d->space = NULL;
+	g->dfa = d;
+}
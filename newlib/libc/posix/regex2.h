@@ -133,6 +133,56 @@ typedef struct {
 /* stuff for character categories */
 typedef unsigned char cat_t;
 
+/*
+ * Lazily built DFA used in place of fast() for patterns without back
+ * references.  A DFA state is a set of strip states, as seen before
+ * the next character is examined, along with the kind of character
+ * preceding it, which decides how ^, $ and word boundaries apply.
+ * Characters which no part of the pattern can tell apart share a
+ * class, and transitions are indexed by class.  States and
+ * transitions are computed with step() the first time they are
+ * needed; when the cache fills up it is emptied and refilled, and if
+ * that happens too often the search finishes with fast() instead.
+ */
+#define	DFA_MEMORY	8192	/* bytes of state cache per regex */
+#define	DFA_MINSTATES	8	/* smaller caches aren't worth using */
+#define	DFA_MAXSTATES	256
+#define	DFA_MINRUN	4	/* chars per cached state between flushes */
+
+/* kinds of preceding character */
+#define	DFA_CTX_BOL	0	/* start of string */
+#define	DFA_CTX_NOTBOL	1	/* start of string, REG_NOTBOL */
+#define	DFA_CTX_NEWLINE	2	/* newline, REG_NEWLINE */
+#define	DFA_CTX_WORD	3	/* word character */
+#define	DFA_CTX_OTHER	4	/* anything else */
+#define	DFA_NCTX	5
+
+/* transition values other than a state number */
+#define	DFA_UNKNOWN	(-1)	/* not computed yet */
+#define	DFA_ACCEPT	(-2)	/* match found before this character */
+
+/* dfast() results */
+#define	DFA_NOMATCH	0
+#define	DFA_MATCH	1
+#define	DFA_GIVEUP	2	/* continue with fast() */
+
+struct re_dfa {
+	int busy;		/* claimed by a regexec() call */
+	int nclasses;		/* number of character classes */
+	uch classes[NC];	/* class of each character, by (uch) */
+	uch ctxs[NC];		/* DFA_CTX_ value of each character */
+	size_t setsize;		/* bytes in a stored state set */
+	int maxstates;		/* capacity of the cache */
+	int nstates;		/* states in the cache */
+	short start[DFA_NCTX];	/* starting state after each kind */
+	char *space;		/* storage for the arrays below */
+	uch *sets;		/* [maxstates][setsize] strip states */
+	unsigned *hashes;	/* [maxstates] hash of each set */
+	uch *kinds;		/* [maxstates] DFA_CTX_ of each state */
+	uch *fresh;		/* [maxstates] set is the starting set */
+	short *next;		/* [maxstates][nclasses] transitions */
+};
+
 /*
  * main compiled-expression structure
  */
@@ -158,12 +208,15 @@ struct re_guts {
 	cat_t *categories;	/* ->catspace[-CHAR_MIN] */
 	char *must;		/* match must contain this string */
 	int moffset;		/* latest point at which must may be located */
+	char *prefix;		/* every match starts with this */
+	int plen;		/* length of prefix */
 	int *charjump;		/* Boyer-Moore char jump table */
 	int *matchjump;		/* Boyer-Moore match jump table */
 	int mlen;		/* length of must */
 	size_t nsub;		/* copy of re_nsub */
 	int backrefs;		/* does it use back references? */
 	sopno nplus;		/* how deep does it nest +s? */
+	struct re_dfa *dfa;	/* lazy DFA, NULL if not usable */
 	/* catspace must be last */
 	cat_t catspace[NC];	/* categories */
 };
@@ -53,6 +53,7 @@ static char sccsid[] = "@(#)regexec.c	8.3 (Berkeley) 3/20/94";
 #include <limits.h>
 #include <ctype.h>
 #include <regex.h>
+#include <sys/lock.h>
 
 #include "utils.h"
 #include "regex2.h"
@@ -61,6 +62,85 @@ static char sccsid[] = "@(#)regexec.c	8.3 (Berkeley) 3/20/94";
 static int nope = 0;		/* for use in asserts; shuts lint up */
 #endif
 
+/*
+ * Find the first place at or after p where the literal string lit
+ * appears, or NULL if it doesn't appear before stop.
+ */
+static char *
+litfind(char *p, char *stop, const char *lit, int len)
+{
+	while (stop - p >= len) {
+		p = memchr(p, lit[0], (size_t)(stop - p - len + 1));
+		if (p == NULL)
+			return(NULL);
+		if (memcmp(p + 1, lit + 1, (size_t)(len - 1)) == 0)
+			return(p);
+		p++;
+	}
+	return(NULL);
+}
+
+/*
+ * Empty the lazy DFA cache
+ */
+static void
+dfaflush(struct re_dfa *d)
+{
+	int k;
+
+	d->nstates = 0;
+	for (k = 0; k < DFA_NCTX; k++)
+		d->start[k] = DFA_UNKNOWN;
+}
+
+/*
+ * Claim the lazy DFA for one search, allocating its tables the first
+ * time through.  Only one search uses it at a time; the others, and
+ * any search using a different state representation, go without.
+ */
+static struct re_dfa *
+dfaclaim(struct re_guts *g, size_t setsize)
+{
+	struct re_dfa *d = g->dfa;
+	size_t nstates;
+
+	if (d == NULL || d->setsize != setsize)
+		return(NULL);
+	__LIBC_LOCK();
+	if (d->busy)
+		d = NULL;
+	else
+		d->busy = 1;
+	__LIBC_UNLOCK();
+	if (d == NULL || d->space != NULL)
+		return(d);
+
+	/* one extra set to hold a state while it is being looked up */
+	nstates = (size_t)d->maxstates;
+	d->space = malloc(nstates * (sizeof(unsigned) +
+				     d->nclasses * sizeof(short) + 2) +
+			  (nstates + 1) * d->setsize);
+	if (d->space == NULL) {
+		d->busy = 0;
+		return(NULL);
+	}
+	d->hashes = (unsigned *)d->space;
+	d->next = (short *)(d->hashes + nstates);
+	d->sets = (uch *)(d->next + nstates * d->nclasses);
+	d->kinds = d->sets + (nstates + 1) * d->setsize;
+	d->fresh = d->kinds + nstates;
+	dfaflush(d);
+	return(d);
+}
+
+static void
+dfarelease(struct re_dfa *d)
+{
+	__LIBC_LOCK();
+	d->busy = 0;
+	__LIBC_UNLOCK();
+}
+
 /* macros for manipulating states, small version */
 #define	states	long
 #define	states1	states		/* for later use in regexec() decision */
@@ -83,6 +163,10 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #define	FWD(dst, src, n)	((dst) |= ((unsigned long)(src)&(here)) << (n))
 #define	BACK(dst, src, n)	((dst) |= ((unsigned long)(src)&(here)) >> (n))
 #define	ISSETBACK(v, n)	(((v) & ((unsigned long)here >> (n))) != 0)
+/* copying state sets to and from the DFA cache */
+#define	STATEBYTES	sizeof(long)
+#define	SAVESTATES(b, v)	memcpy(b, &(v), sizeof(long))
+#define	LOADSTATES(v, b)	memcpy(&(v), b, sizeof(long))
 /* function names */
 #define SNAMES			/* engine.c looks after details */
 
@@ -107,6 +191,9 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #undef	FWD
 #undef	BACK
 #undef	ISSETBACK
+#undef	STATEBYTES
+#undef	SAVESTATES
+#undef	LOADSTATES
 #undef	SNAMES
 
 /* macros for manipulating states, large version */
@@ -132,6 +219,10 @@ static int nope = 0;		/* for use in asserts; shuts lint up */
 #define	FWD(dst, src, n)	((dst)[here+(n)] |= (src)[here])
 #define	BACK(dst, src, n)	((dst)[here-(n)] |= (src)[here])
 #define	ISSETBACK(v, n)	((v)[here - (n)])
+/* copying state sets to and from the DFA cache */
+#define	STATEBYTES	((size_t)m->g->nstates)
+#define	SAVESTATES(b, v)	memcpy(b, v, m->g->nstates)
+#define	LOADSTATES(v, b)	memcpy(v, b, m->g->nstates)
 /* function names */
 #define	LNAMES			/* flag */
 
@@ -74,10 +74,16 @@ regfree(regex_t *preg)
 		free((char *)g->setbits);
 	if (g->must != NULL)
 		free(g->must);
+	if (g->prefix != NULL)
+		free(g->prefix);
 	if (g->charjump != NULL)
                 free(g->charjump);
 	if (g->matchjump != NULL)
 		free(g->matchjump);
+	if (g->dfa != NULL) {
+		free(g->dfa->space);
+		free(g->dfa);
+	}
 	free((char *)g);
 }
 
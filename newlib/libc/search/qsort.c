@@ -69,6 +69,7 @@ PORTABILITY
 #endif
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 #if defined(I_AM_QSORT_R)
 typedef int		 cmp_t(void *, const void *, const void *);
@@ -78,14 +79,42 @@ typedef int		 cmp_t(const void *, const void *, void *);
 typedef int		 cmp_t(const void *, const void *);
 #endif
 static inline char	*med3 (char *, char *, char *, cmp_t *, void *);
-static inline void	 swapfunc(char *, char *, size_t, int, int);
 
 #define min(a, b)	(a) < (b) ? a : b
 
 typedef unsigned int swap_uint_t;
 typedef unsigned long swap_ulong_t;
 
-#define need_both_sizes() (sizeof(swap_uint_t) != sizeof(swap_ulong_t))
+/*
+ * How elements are exchanged, picked once from the element size and
+ * the alignment of the array. The common 4, 8 and 16 byte elements
+ * are moved with a single pair of loads and stores each.
+ */
+#define SWAP_32		0	/* one uint32_t */
+#define SWAP_64		1	/* one uint64_t */
+#define SWAP_128	2	/* two uint64_t */
+#define SWAP_LONGS	3	/* a multiple of long */
+#define SWAP_INTS	4	/* a multiple of int */
+#define SWAP_BYTES	5
+
+#define aligned(a, es, TYPE) \
+	((uintptr_t)(a) % sizeof(TYPE) == 0 && (es) % sizeof(TYPE) == 0)
+
+static inline int
+swapinit(void *a, size_t es)
+{
+	if (es == 4 && aligned(a, es, uint32_t))
+		return SWAP_32;
+	if (es == 8 && aligned(a, es, uint64_t))
+		return SWAP_64;
+	if (es == 16 && aligned(a, es, uint64_t))
+		return SWAP_128;
+	if (aligned(a, es, swap_ulong_t))
+		return SWAP_LONGS;
+	if (aligned(a, es, swap_uint_t))
+		return SWAP_INTS;
+	return SWAP_BYTES;
+}
 
 /*
  * Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
@@ -101,35 +130,64 @@ typedef unsigned long swap_ulong_t;
                 } while (--i > 0);              \
         } while(0)
 
-#define	SWAPINIT(TYPE, a, es) swaptype_ ## TYPE =	\
-	((uintptr_t)(a) % sizeof(TYPE)) ||	\
-	((es) % sizeof(TYPE)) ? 2 : ((es) == sizeof(TYPE)) ? 0 : 1;
-
+/* Exchange n bytes, a multiple of the element size */
 static inline void
-swapfunc(char *a, char *b, size_t n, int swaptype_swap_ulong_t, int swaptype_swap_uint_t)
+swapfunc(char *a, char *b, size_t n, int swaptype)
 {
-	if (swaptype_swap_ulong_t <= 1)
+	switch (swaptype) {
+	case SWAP_32:
+		swapcode(uint32_t, a, b, n);
+		break;
+	case SWAP_64:
+	case SWAP_128:
+		swapcode(uint64_t, a, b, n);
+		break;
+	case SWAP_LONGS:
 		swapcode(swap_ulong_t, a, b, n);
-        else if (need_both_sizes() && swaptype_swap_uint_t <= 1)
-                swapcode(swap_uint_t, a, b, n);
-	else
+		break;
+	case SWAP_INTS:
+		swapcode(swap_uint_t, a, b, n);
+		break;
+	default:
 		swapcode(unsigned char, a, b, n);
+		break;
+	}
 }
 
-#define	swap(a, b)                                                      \
-        if (swaptype_swap_ulong_t == 0) {                               \
-                swap_ulong_t t = *(swap_ulong_t *)(a);                  \
-                *(swap_ulong_t *)(a) = *(swap_ulong_t *)(b);            \
-                *(swap_ulong_t *)(b) = t;                               \
-        } else if (need_both_sizes() && swaptype_swap_uint_t == 0) {    \
-                swap_uint_t t = *(swap_uint_t *)(a);                    \
-                *(swap_uint_t *)(a) = *(swap_uint_t *)(b);              \
-                *(swap_uint_t *)(b) = t;                                \
-        } else                                                          \
-                swapfunc(a, b, es, swaptype_swap_ulong_t, swaptype_swap_uint_t)
+/* Exchange two elements */
+static inline void
+swap(char *a, char *b, size_t es, int swaptype)
+{
+	uint32_t t32;
+	uint64_t t64, u64;
+
+	switch (swaptype) {
+	case SWAP_32:
+		t32 = *(uint32_t *) a;
+		*(uint32_t *) a = *(uint32_t *) b;
+		*(uint32_t *) b = t32;
+		break;
+	case SWAP_64:
+		t64 = *(uint64_t *) a;
+		*(uint64_t *) a = *(uint64_t *) b;
+		*(uint64_t *) b = t64;
+		break;
+	case SWAP_128:
+		t64 = ((uint64_t *) a)[0];
+		u64 = ((uint64_t *) a)[1];
+		((uint64_t *) a)[0] = ((uint64_t *) b)[0];
+		((uint64_t *) a)[1] = ((uint64_t *) b)[1];
+		((uint64_t *) b)[0] = t64;
+		((uint64_t *) b)[1] = u64;
+		break;
+	default:
+		swapfunc(a, b, es, swaptype);
+		break;
+	}
+}
 
 #define	vecswap(a, b, n)				\
-	if ((n) > 0) swapfunc(a, b, n, swaptype_swap_ulong_t, swaptype_swap_uint_t)
+	if ((n) > 0) swapfunc(a, b, n, swaptype)
 
 #if defined(I_AM_QSORT_R)
 #define	CMP(t, x, y) (cmp((t), (x), (y)))
@@ -139,22 +197,93 @@ swapfunc(char *a, char *b, size_t n, int swaptype_swap_ulong_t, int swaptype_swa
 #define	CMP(t, x, y) (cmp((x), (y)))
 #endif
 
+#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
+#define __thunk_unused	__unused
+#else
+#define __thunk_unused
+#endif
+
 static __inline char *
 med3 (char *a,
 	char *b,
 	char *c,
 	cmp_t *cmp,
-	void *thunk
-#if !defined(I_AM_QSORT_R) && !defined(I_AM_GNU_QSORT_R)
-__unused
-#endif
-)
+	void *thunk __thunk_unused)
 {
 	return CMP(thunk, a, b) < 0 ?
 	       (CMP(thunk, b, c) < 0 ? b : (CMP(thunk, a, c) < 0 ? c : a ))
               :(CMP(thunk, b, c) > 0 ? b : (CMP(thunk, a, c) < 0 ? a : c ));
 }
 
+static void
+insertion_sort(char *a, size_t n, size_t es, cmp_t *cmp,
+	       void *thunk __thunk_unused, int swaptype)
+{
+	char *pl, *pm;
+
+	for (pm = a + es; pm < a + n * es; pm += es)
+		for (pl = pm; pl > a && CMP(thunk, pl - es, pl) > 0; pl -= es)
+			swap(pl, pl - es, es, swaptype);
+}
+
+/*
+ * Insertion sort which gives up once it has moved elements n places
+ * in total. This sorts arrays which are nearly in order in linear
+ * time, while keeping the work wasted on other arrays linear too so
+ * the whole sort stays O(n log n). Returns whether the array was
+ * sorted.
+ */
+static bool
+partial_insertion_sort(char *a, size_t n, size_t es, cmp_t *cmp,
+		       void *thunk __thunk_unused, int swaptype)
+{
+	char *pl, *pm;
+	size_t moved = 0;
+
+	for (pm = a + es; pm < a + n * es; pm += es) {
+		for (pl = pm; pl > a && CMP(thunk, pl - es, pl) > 0; pl -= es) {
+			if (++moved > n)
+				return false;
+			swap(pl, pl - es, es, swaptype);
+		}
+	}
+	return true;
+}
+
+/*
+ * Heapsort, used when partitioning isn't making progress. This puts
+ * an O(n log n) bound on the whole sort, whatever the input.
+ */
+static void
+siftdown(char *a, size_t root, size_t n, size_t es, cmp_t *cmp,
+	 void *thunk __thunk_unused, int swaptype)
+{
+	size_t child;
+
+	while ((child = 2 * root + 1) < n) {
+		if (child + 1 < n &&
+		    CMP(thunk, a + child * es, a + (child + 1) * es) < 0)
+			child++;
+		if (CMP(thunk, a + root * es, a + child * es) >= 0)
+			break;
+		swap(a + root * es, a + child * es, es, swaptype);
+		root = child;
+	}
+}
+
+static void
+heap_sort(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk, int swaptype)
+{
+	size_t i;
+
+	for (i = n / 2; i > 0; i--)
+		siftdown(a, i - 1, n, es, cmp, thunk, swaptype);
+	for (i = n - 1; i > 0; i--) {
+		swap(a, a + i * es, es, swaptype);
+		siftdown(a, 0, i, es, cmp, thunk, swaptype);
+	}
+}
+
 /*
  * Classical function call recursion wastes a lot of stack space. Each
  * recursion level requires a full stack frame comprising all local variables
@@ -171,60 +300,40 @@ __unused
  */
 #define PARAMETER_STACK_LEVELS 8u
 
-#if defined(I_AM_QSORT_R)
-void
-__bsd_qsort_r (void *a,
-	size_t n,
-	size_t es,
-	void *thunk,
-        cmp_t *cmp);
-
-void
-__bsd_qsort_r (void *a,
-	size_t n,
-	size_t es,
-	void *thunk,
-	cmp_t *cmp)
-#elif defined(I_AM_GNU_QSORT_R)
-void
-qsort_r (void *a,
-	size_t n,
-	size_t es,
-	cmp_t *cmp,
-	void *thunk)
-#else
-#define thunk NULL
-void
-qsort (void *a,
-	size_t n,
-	size_t es,
-	cmp_t *cmp)
-#endif
+/*
+ * Introsort: quicksort, switching to heapsort for any part which is
+ * still unsorted after depth partitioning steps.
+ */
+static void
+introsort(char *a, size_t n, size_t es, cmp_t *cmp, void *thunk,
+	  int swaptype, size_t depth)
 {
 	char *pa, *pb, *pc, *pd, *pl, *pm, *pn;
 	size_t d, r;
 	int cmp_result;
-	int swaptype_swap_ulong_t, swaptype_swap_uint_t, swap_cnt;
+	int swap_cnt;
 	size_t recursion_level = 0;
-	struct { void *a; size_t n; } parameter_stack[PARAMETER_STACK_LEVELS];
+	struct { char *a; size_t n; size_t depth; } parameter_stack[PARAMETER_STACK_LEVELS];
 
-	SWAPINIT(swap_ulong_t, a, es);
-	SWAPINIT(swap_uint_t, a, es);
 loop:	swap_cnt = 0;
 	if (n < 7) {
 		/* Short arrays are insertion sorted. */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
+		insertion_sort(a, n, es, cmp, thunk, swaptype);
 		goto pop;
 	}
 
+	if (depth == 0) {
+		/* Too many poor partitions, bound the cost with heapsort. */
+		heap_sort(a, n, es, cmp, thunk, swaptype);
+		goto pop;
+	}
+	depth--;
+
 	/* Select a pivot element, move it to the left. */
-	pm = (char *) a + (n / 2) * es;
+	pm = a + (n / 2) * es;
 	if (n > 7) {
 		pl = a;
-		pn = (char *) a + (n - 1) * es;
+		pn = a + (n - 1) * es;
 		if (n > 40) {
 			d = (n / 8) * es;
 			pl = med3(pl, pl + d, pl + 2 * d, cmp, thunk);
@@ -233,21 +342,21 @@ loop:	swap_cnt = 0;
 		}
 		pm = med3(pl, pm, pn, cmp, thunk);
 	}
-	swap(a, pm);
+	swap(a, pm, es, swaptype);
 
 	/*
 	 * Sort the array relative the pivot in four ranges as follows:
 	 * { elems == pivot, elems < pivot, elems > pivot, elems == pivot }
 	 */
-	pa = pb = (char *) a + es;
-	pc = pd = (char *) a + (n - 1) * es;
+	pa = pb = a + es;
+	pc = pd = a + (n - 1) * es;
 	for (;;) {
 		/* Scan left to right stopping at first element > pivot. */
 		while (pb <= pc && (cmp_result = CMP(thunk, pb, a)) <= 0) {
 			/* Move elements == pivot to the left (to pa) */
 			if (cmp_result == 0) {
 				swap_cnt = 1;
-				swap(pa, pb);
+				swap(pa, pb, es, swaptype);
 				pa += es;
 			}
 			pb += es;
@@ -257,7 +366,7 @@ loop:	swap_cnt = 0;
 			/* Move elements == pivot to the right (to pd) */
 			if (cmp_result == 0) {
 				swap_cnt = 1;
-				swap(pc, pd);
+				swap(pc, pd, es, swaptype);
 				pd -= es;
 			}
 			pc -= es;
@@ -265,25 +374,17 @@ loop:	swap_cnt = 0;
 		if (pb > pc)
 			break;
 		/* The scan has found two elements to swap with each other. */
-		swap(pb, pc);
+		swap(pb, pc, es, swaptype);
 		swap_cnt = 1;
 		pb += es;
 		pc -= es;
 	}
-	if (swap_cnt == 0) {  /* Switch to insertion sort */
-		for (pm = (char *) a + es; pm < (char *) a + n * es; pm += es)
-			for (pl = pm; pl > (char *) a && CMP(thunk, pl - es, pl) > 0;
-			     pl -= es)
-				swap(pl, pl - es);
-		goto pop;
-	}
-
 	/*
 	 * Rearrange the array in three parts sorted like this:
 	 * { elements < pivot, elements == pivot, elements > pivot }
 	 */
-	pn = (char *) a + n * es;
-	r = min(pa - (char *)a, pb - pa);
+	pn = a + n * es;
+	r = min(pa - a, pb - pa);
 	vecswap(a, pb - r, r);
 	r = min((size_t) (pd - pc), (size_t) (pn - pd) - es);
 	vecswap(pb, pn - r, r);
@@ -291,6 +392,18 @@ loop:	swap_cnt = 0;
 	r = pd - pc; /* r = Size of right part. */
 	pn -= r;     /* pn = Base of right part. */
 
+	if (swap_cnt == 0) {
+		/*
+		 * Nothing moved, so the parts may well be in order
+		 * already. Check with an insertion sort which gives up
+		 * after a few moves, leaving the part to be partitioned.
+		 */
+		if (partial_insertion_sort(a, d / es, es, cmp, thunk, swaptype))
+			d = 0;
+		if (partial_insertion_sort(pn, r / es, es, cmp, thunk, swaptype))
+			r = 0;
+	}
+
 	/*
 	 * Check which of the left and right parts are larger.
 	 * Set (a, n)  to (base, size) of the larger part.
@@ -328,6 +441,7 @@ loop:	swap_cnt = 0;
 			 */
 			parameter_stack[recursion_level].a = a;
 			parameter_stack[recursion_level].n = n / es;
+			parameter_stack[recursion_level].depth = depth;
 			recursion_level++;
 			a = pa;
 			n = r / es;
@@ -339,13 +453,7 @@ loop:	swap_cnt = 0;
 			 * is sorted using function call recursion. The larger
 			 * part will be sorted after the function call returns.
 			 */
-#if defined(I_AM_QSORT_R)
-			__bsd_qsort_r(pa, r / es, es, thunk, cmp);
-#elif defined(I_AM_GNU_QSORT_R)
-			qsort_r(pa, r / es, es, cmp, thunk);
-#else
-			qsort(pa, r / es, es, cmp);
-#endif
+			introsort(pa, r / es, es, cmp, thunk, swaptype, depth);
 		}
 	}
 	if (n > es) {  /* The larger part needs sorting. Iterate to sort.  */
@@ -358,6 +466,46 @@ pop:
 		recursion_level--;
 		a = parameter_stack[recursion_level].a;
 		n = parameter_stack[recursion_level].n;
+		depth = parameter_stack[recursion_level].depth;
 		goto loop;
 	}
 }
+
+#if defined(I_AM_QSORT_R)
+void
+__bsd_qsort_r (void *a,
+	size_t n,
+	size_t es,
+	void *thunk,
+        cmp_t *cmp);
+
+void
+__bsd_qsort_r (void *a,
+	size_t n,
+	size_t es,
+	void *thunk,
+	cmp_t *cmp)
+#elif defined(I_AM_GNU_QSORT_R)
+void
+qsort_r (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp,
+	void *thunk)
+#else
+#define thunk NULL
+void
+qsort (void *a,
+	size_t n,
+	size_t es,
+	cmp_t *cmp)
+#endif
+{
+	size_t depth = 0;
+	size_t m;
+
+	/* Allow 2 * log2(n) partitioning steps before using heapsort */
+	for (m = n; m > 1; m >>= 1)
+		depth += 2;
+	introsort(a, n, es, cmp, thunk, swapinit(a, es), depth);
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "malloc_arena.h"
+
+/*
+ * Resize 'ptr', an allocation of 'old_size' bytes from 'arena'. The
+ * most recent allocation is resized in place. Others are copied to
+ * a new allocation when they grow; their old space is not reused
+ * until the arena is reset.
+ */
+void *
+malloc_arena_realloc(struct malloc_arena *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    char *ret;
+
+    if (ptr && (char *) ptr + malloc_arena_size(old_size) == arena->pos) {
+        if (new_size > (size_t) (arena->end - (char *) ptr)) {
+            errno = ENOMEM;
+            return NULL;
+        }
+        arena->pos = (char *) ptr + malloc_arena_size(new_size);
+        return ptr;
+    }
+    if (new_size <= old_size)
+        return ptr;
+    ret = malloc_arena_alloc(arena, new_size);
+    if (ret && ptr)
+        memcpy(ret, ptr, old_size);
+    return ret;
+}
@@ -309,6 +309,9 @@ __ucs4_mbtowc (
     if (n < 4)
         return -1;
     memcpy(&uchar, s, 4);
+    /* Reject values beyond Unicode or which don't fit in wchar_t */
+    if (uchar > 0x10ffff || (uint32_t) (wchar_t) uchar != uchar)
+        return -1;
     *pwc = uchar;
     return 4;
 }
@@ -326,7 +329,11 @@ __ucs4swap_mbtowc (
     if (n < 4)
         return -1;
     memcpy(&uchar, s, 4);
-    *pwc = __bswap32(uchar);
+    uchar = __bswap32(uchar);
+    /* Reject values beyond Unicode or which don't fit in wchar_t */
+    if (uchar > 0x10ffff || (uint32_t) (wchar_t) uchar != uchar)
+        return -1;
+    *pwc = uchar;
     return 4;
 }
 
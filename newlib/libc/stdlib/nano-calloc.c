@@ -31,7 +31,7 @@
 
 /*
  * Implement calloc by multiplying sizes (with overflow check) and
- * calling malloc (which already sets to zero)
+ * allocating memory set to zero
  */
 
 void *
@@ -44,5 +44,5 @@ calloc(size_t n, size_t elem)
         errno = ENOMEM;
         return NULL;
     }
-    return malloc(bytes);
+    return __malloc_alloc(bytes, true);
 }
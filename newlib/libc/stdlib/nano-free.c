@@ -35,30 +35,65 @@
  *  When free, insert the to-be-freed chunk_t into free list. The place to
  *  insert should make sure all chunks are sorted by address from low to
  *  high.  Then merge with neighbor chunks if adjacent.
+ *
+ *  With __NANO_MALLOC_TLSF, the header flags and footers locate free
+ *  neighbors directly. Merge with those and insert the result at the
+ *  head of the list for its size class.
+ *
+ *  With __NANO_MALLOC_THREAD_CACHE, small chunks go to the thread
+ *  cache first.
  */
 
-void
-free (void * free_p)
+/* Return a chunk to the free list. Called with the lock held */
+static void
+__malloc_release(chunk_t *p_to_free)
 {
-    chunk_t     *p_to_free;
+#ifdef __NANO_MALLOC_TLSF
+    chunk_t     *r;
+#else
     chunk_t     **p, *r;
+#endif
 
-    if (free_p == NULL) return;
+#ifdef __NANO_MALLOC_TLSF
+    r = chunk_after(p_to_free);
 
-    p_to_free = ptr_to_chunk(free_p);
+    /* Check for double free */
+    if (_prev_free(r))
+    {
+        errno = ENOMEM;
+        return;
+    }
 
+    /* Merge blocks together */
+    if (chunk_is_free(r))
+    {
+        _free_list_remove(r);
+        *_size_ref(p_to_free) += _size(r);
 #ifdef __NANO_MALLOC_CLEAR_FREED
-    memset(p_to_free, 0, chunk_usable(p_to_free));
-#else
-    p_to_free->next = NULL;
+        /* Keep free memory zero apart from links and footer */
+        *_size_ref(r) = 0;
+        r->next = NULL;
+        r->prev = NULL;
 #endif
+    }
 
-#if MALLOC_DEBUG
-    __malloc_validate_block(p_to_free);
+    if (_prev_free(p_to_free))
+    {
+        r = chunk_before(p_to_free);
+        _free_list_remove(r);
+        *_size_ref(r) += _size(p_to_free);
+#ifdef __NANO_MALLOC_CLEAR_FREED
+        /* Clear the footer of r and our header */
+        _size_ref(p_to_free)[-1] = 0;
+        *_size_ref(p_to_free) = 0;
 #endif
+        p_to_free = r;
+    }
 
-    MALLOC_LOCK;
-
+    _set_footer(p_to_free);
+    _set_prev_free(chunk_after(p_to_free));
+    _free_list_insert(p_to_free);
+#else
     for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
     {
 	/* Insert in address order */
@@ -68,7 +103,7 @@ free (void * free_p)
             if (p_to_free == r)
             {
                 errno = ENOMEM;
-                goto unlock;
+                return;
             }
 
 	    break;
@@ -78,6 +113,10 @@ free (void * free_p)
 	if (chunk_after(r) == p_to_free)
 	{
 	    *_size_ref(r) += _size(p_to_free);
+#ifdef __NANO_MALLOC_CLEAR_FREED
+            /* Keep free memory zero apart from the links */
+            *_size_ref(p_to_free) = 0;
+#endif
 	    p_to_free = r;
 	    r = r->next;
 	    goto no_insert;
@@ -104,9 +143,110 @@ no_insert:
 #pragma GCC diagnostic pop
 #endif
 	p_to_free->next = r->next;
+#ifdef __NANO_MALLOC_CLEAR_FREED
+        *_size_ref(r) = 0;
+        r->next = NULL;
+#endif
     }
+#endif
+}
+
+#ifdef __NANO_MALLOC_THREAD_CACHE
+
+/*
+ * Hold chunks of the cached sizes in the thread cache, returning
+ * some of them to the heap when it fills up
+ */
+static bool
+__malloc_cache_put(chunk_t *c)
+{
+    struct malloc_cache *cache = &__malloc_cache;
+    size_t bin = _cache_bin(_size(c));
+    chunk_t *r;
+
+    if (bin >= MALLOC_CACHE_BINS || _size(c) != _cache_size(bin))
+        return false;
+
+    /* Check for double free */
+    for (r = cache->bins[bin]; r; r = r->next)
+    {
+        if (r == c)
+        {
+            errno = ENOMEM;
+            return true;
+        }
+    }
+
+    c->next = cache->bins[bin];
+    cache->bins[bin] = c;
+    if (++cache->count[bin] > MALLOC_CACHE_MAX)
+        __malloc_cache_flush(bin, MALLOC_CACHE_MAX / 2);
+    return true;
+}
 
-unlock:
+void
+__malloc_cache_flush(size_t bin, size_t count)
+{
+    struct malloc_cache *cache = &__malloc_cache;
+    chunk_t *c;
+
+    MALLOC_LOCK;
+    while (count-- && (c = cache->bins[bin]) != NULL)
+    {
+        cache->bins[bin] = c->next;
+        cache->count[bin]--;
+        c->next = NULL;
+        __malloc_release(c);
+    }
+    MALLOC_UNLOCK;
+}
+
+#endif
+
+/*
+ * Return all of the calling thread's cached chunks to the heap. Chunks
+ * still cached when a thread goes away are lost, so the system should
+ * call this as each thread exits, while its TLS block is still valid
+ */
+void
+__malloc_thread_exit(void)
+{
+#ifdef __NANO_MALLOC_THREAD_CACHE
+    size_t bin;
+
+    for (bin = 0; bin < MALLOC_CACHE_BINS; bin++)
+        __malloc_cache_flush(bin, SIZE_MAX);
+#endif
+}
+
+void
+free (void * free_p)
+{
+    chunk_t     *p_to_free;
+
+    if (free_p == NULL) return;
+
+    _malloc_count_free();
+
+    p_to_free = ptr_to_chunk(free_p);
+
+#ifdef __NANO_MALLOC_CLEAR_FREED
+    memset(p_to_free, 0, chunk_usable(p_to_free));
+#else
+    p_to_free->next = NULL;
+#endif
+
+#if MALLOC_DEBUG
+    __malloc_validate_block(p_to_free);
+#endif
+
+#ifdef __NANO_MALLOC_THREAD_CACHE
+    if (__malloc_cache_put(p_to_free))
+        return;
+#endif
+
+    MALLOC_LOCK;
+    __malloc_release(p_to_free);
     MALLOC_UNLOCK;
 }
 
@@ -39,6 +39,11 @@ mallinfo(void)
     struct mallinfo current_mallinfo;
     memset(&current_mallinfo, 0, sizeof(current_mallinfo));
 
+#ifdef __NANO_MALLOC_THREAD_CACHE
+    /* Return this thread's cached chunks so that they count as free */
+    __malloc_thread_exit();
+#endif
+
     MALLOC_LOCK;
 
     if (__malloc_sbrk_start == NULL) total_size = 0;
@@ -51,10 +56,21 @@ mallinfo(void)
             total_size = (size_t) (sbrk_now - __malloc_sbrk_start);
     }
 
+#ifdef __NANO_MALLOC_TLSF
+    int fl, sl;
+
+    for (fl = 0; fl < (int) MALLOC_FL; fl++)
+        for (sl = 0; sl < MALLOC_SL; sl++)
+            for (pf = __malloc_free_lists[fl][sl]; pf; pf = pf->next) {
+                ordblks++;
+                free_size += _size(pf);
+            }
+#else
     for (pf = __malloc_free_list; pf; pf = pf->next) {
 	ordblks++;
         free_size += _size(pf);
     }
+#endif
 
     current_mallinfo.ordblks = ordblks;
     current_mallinfo.arena = total_size;
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "nano-malloc.h"
+
+/** Function malloc_instrument
+  * Algorithm:
+  *   Copy the recorded counts, then walk the free lists to measure
+  *   their length, the largest free chunk and how much of the free
+  *   space lies outside of it. Chunks held in the thread cache are
+  *   not counted as free.
+  */
+int
+malloc_instrument(struct malloc_instrument *mi)
+{
+    chunk_t *pf;
+    size_t size;
+
+    MALLOC_LOCK;
+
+#ifdef __NANO_MALLOC_INSTRUMENT
+    *mi = __malloc_counts;
+#else
+    memset(mi, 0, sizeof(*mi));
+#endif
+    mi->free_chunks = 0;
+    mi->free_bytes = 0;
+    mi->largest_free = 0;
+
+#ifdef __NANO_MALLOC_TLSF
+    int fl, sl;
+
+    for (fl = 0; fl < (int) MALLOC_FL; fl++)
+        for (sl = 0; sl < MALLOC_SL; sl++)
+            for (pf = __malloc_free_lists[fl][sl]; pf; pf = pf->next) {
+                size = _size(pf);
+                mi->free_chunks++;
+                mi->free_bytes += size;
+                mi->largest_free = MAX(mi->largest_free, size);
+            }
+#else
+    for (pf = __malloc_free_list; pf; pf = pf->next) {
+        size = _size(pf);
+        mi->free_chunks++;
+        mi->free_bytes += size;
+        mi->largest_free = MAX(mi->largest_free, size);
+    }
+#endif
+
+    MALLOC_UNLOCK;
+
+    mi->fragmentation = 0;
+    if (mi->free_bytes)
+        mi->fragmentation = (size_t) ((unsigned long long) (mi->free_bytes - mi->largest_free) * 1000 /
+                                      mi->free_bytes);
+    return 0;
+}
@@ -42,4 +42,35 @@ malloc_stats(void)
             (long) current_mallinfo.uordblks);
     fprintf(stderr, "free blocks      = %10lu\n",
 	    (long) current_mallinfo.ordblks);
+
+#ifdef __NANO_MALLOC_INSTRUMENT
+    struct malloc_instrument mi;
+    int bin;
+
+    malloc_instrument(&mi);
+    fprintf(stderr, "largest free     = %10lu\n",
+            (unsigned long) mi.largest_free);
+    fprintf(stderr, "fragmentation    = %10lu / 1000\n",
+            (unsigned long) mi.fragmentation);
+    fprintf(stderr, "allocations      = %10lu\n",
+            (unsigned long) mi.alloc_calls);
+    fprintf(stderr, "failures         = %10lu\n",
+            (unsigned long) mi.alloc_failures);
+    fprintf(stderr, "frees            = %10lu\n",
+            (unsigned long) mi.free_calls);
+    fprintf(stderr, "chunks walked    = %10lu\n",
+            (unsigned long) mi.walk_total);
+    fprintf(stderr, "longest walk     = %10lu\n",
+            (unsigned long) mi.walk_max);
+    for (bin = 0; bin < MALLOC_HISTOGRAM_BINS; bin++) {
+        if (!mi.size_histogram[bin])
+            continue;
+        if (bin == MALLOC_HISTOGRAM_BINS - 1)
+            fprintf(stderr, "size >= %8lu = %10lu\n",
+                    16UL << (bin - 1), (unsigned long) mi.size_histogram[bin]);
+        else
+            fprintf(stderr, "size <  %8lu = %10lu\n",
+                    16UL << bin, (unsigned long) mi.size_histogram[bin]);
+    }
+#endif
 }
@@ -28,25 +28,27 @@
 
 #include "nano-malloc.h"
 
+#ifdef __NANO_MALLOC_TLSF
+/* Segregated free lists and bitmaps of which lists are not empty */
+size_t __malloc_fl_map;
+uint8_t __malloc_sl_map[MALLOC_FL];
+chunk_t *__malloc_free_lists[MALLOC_FL][MALLOC_SL];
+#else
 /* List list header of free blocks */
 chunk_t *__malloc_free_list;
+#endif
 
 /* Starting point of memory allocated from system */
 char * __malloc_sbrk_start;
 char * __malloc_sbrk_top;
 
-/*
- * Algorithm:
- *   Use sbrk() to obtain more memory and ensure the storage is
- *   MALLOC_CHUNK_ALIGN aligned. Optimise for the case that it is
- *   already aligned - only ask for extra padding after we know we
- *   need it
- */
+#ifdef __NANO_MALLOC_INSTRUMENT
+struct malloc_instrument __malloc_counts;
+#endif
+
 static void *
-__malloc_sbrk_aligned(size_t s)
+__malloc_sbrk(size_t s)
 {
-    char *p, *align_p;
-
 #ifdef __APPLE__
     /* Mac OS X 'emulates' sbrk, but the
      * parameter is int, not intptr_t or ptrdiff_t,
@@ -60,7 +62,229 @@ __malloc_sbrk_aligned(size_t s)
     if (d < 0)
 	return (void *)-1;
 #endif
-    p = sbrk(d);
+    return sbrk(d);
+}
+
+#ifdef __NANO_MALLOC_TLSF
+
+/*
+ * Mark 'c' as the last chunk in a heap region by following it with a
+ * zero-sized header
+ */
+static void
+__malloc_set_end(chunk_t *c)
+{
+    chunk_t *e = chunk_after(c);
+
+    __malloc_sbrk_top = (char *) e;
+    _set_size(e, 0);
+}
+
+/*
+ * Algorithm:
+ *   Use sbrk() to obtain a chunk of at least 'alloc_size' bytes. When
+ *   the new memory is contiguous with the heap, it extends any free
+ *   chunk at the top. Otherwise, start a new region, asking for a few
+ *   more bytes to align the chunk and hold the end marker. Set
+ *   'clean' to the number of bytes at the start of the chunk which
+ *   came from the free chunk.
+ */
+static chunk_t *
+__malloc_sbrk_chunk(size_t alloc_size, size_t *clean)
+{
+    char *top = __malloc_sbrk_top;
+    chunk_t *c = NULL;
+    size_t need = alloc_size;
+    char *p;
+
+    if (top && _prev_free((chunk_t *) top))
+    {
+	c = chunk_before((chunk_t *) top);
+	_free_list_remove(c);
+	*clean = chunk_usable(c);
+	if (_size(c) >= alloc_size)
+	    return c;
+	need -= _size(c);
+	*clean -= sizeof(size_t);
+    }
+
+    p = __malloc_sbrk(need);
+
+    if (p != (char *) -1 && p == top)
+    {
+	/* The old end marker becomes the header of the new memory */
+	if (c)
+	    *_size_ref(c) += need;
+	else
+	{
+	    *clean = 0;
+	    c = (chunk_t *) top;
+	    _set_size(c, need);
+	}
+	__malloc_set_end(c);
+	return c;
+    }
+
+    /* Put back any free chunk from the top of the old region */
+    if (c)
+	_free_list_insert(c);
+
+    if (p == (char *) -1)
+	return NULL;
+
+    *clean = 0;
+    c = (chunk_t *) __align_up(p + MALLOC_HEAD, MALLOC_CHUNK_ALIGN);
+    if (__malloc_sbrk((char *) c + alloc_size - (p + need)) != p + need)
+	return NULL;
+    /* Start the heap at the first chunk, not its header, so that the
+     * reported size of the heap excludes the end marker */
+    if (__malloc_sbrk_start == NULL)
+	__malloc_sbrk_start = (char *) c;
+    _set_size(c, alloc_size);
+    __malloc_set_end(c);
+    return c;
+}
+
+bool
+__malloc_grow_chunk(chunk_t *c, size_t new_size)
+{
+    chunk_t *e = chunk_after(c);
+
+    if ((char *) e != __malloc_sbrk_top)
+	return false;
+    size_t add_size = MAX(MALLOC_MINSIZE, new_size - _size(c));
+
+    /* Ask for the extra memory needed */
+    char *heap = __malloc_sbrk(add_size);
+
+    /* Check if we got what we wanted */
+    if (heap == (char *) e)
+    {
+	/* Set size and move the end marker */
+	*_size_ref(c) += add_size;
+	__malloc_set_end(c);
+	return true;
+    }
+
+    if (heap != (char *) -1)
+    {
+	/* sbrk returned unexpected memory, make it a new region and
+	 * free it */
+	chunk_t *r = (chunk_t *) __align_up(heap + MALLOC_HEAD, MALLOC_CHUNK_ALIGN);
+	size_t size = __align_down((size_t) (heap + add_size - (char *) r), MALLOC_CHUNK_ALIGN);
+
+	if (size >= MALLOC_MINSIZE)
+	{
+	    _set_size(r, size);
+	    __malloc_set_end(r);
+	    __malloc_free(chunk_to_ptr(r));
+	}
+    }
+    return false;
+}
+
+/*
+ * Find a free chunk holding at least 'size' bytes. Round the request
+ * up to the next size class so that any chunk in the selected list
+ * is large enough, then use the bitmaps to locate the first
+ * non-empty list at or above that.
+ */
+static chunk_t *
+__malloc_find_chunk(size_t size)
+{
+    size_t round = ((size_t) 1 << (_malloc_log2(size) - MALLOC_SL_LOG2)) - 1;
+    size_t fl_map;
+    unsigned sl_map;
+    int fl, sl;
+
+    if (size + round < size)
+	return NULL;
+
+    (void) _free_list_head(size + round, &fl, &sl);
+
+    sl_map = __malloc_sl_map[fl] & (~0U << sl);
+    if (!sl_map)
+    {
+	fl_map = __malloc_fl_map & (~(size_t) 0 << (fl + 1));
+	if (!fl_map)
+	    return NULL;
+	fl = _malloc_ffs(fl_map);
+	sl_map = __malloc_sl_map[fl];
+    }
+    sl = _malloc_ffs(sl_map);
+    return __malloc_free_lists[fl][sl];
+}
+
+/** Function __malloc_take_chunk
+  * Algorithm:
+  *   Take the first chunk from the smallest non-empty size class
+  *   which is large enough and split off any excess. If there isn't
+  *   one, call sbrk to allocate a new chunk_t. Set 'clean' to the
+  *   number of bytes at the start of the chunk which came from the
+  *   free lists.
+  */
+static chunk_t *
+__malloc_take_chunk(size_t alloc_size, size_t *clean)
+{
+    chunk_t *r;
+    size_t rem;
+
+    MALLOC_LOCK;
+
+    r = __malloc_find_chunk(alloc_size);
+    /* The bitmaps lead directly to a suitable chunk */
+    _malloc_count_walk(r != NULL);
+    if (r)
+	_free_list_remove(r);
+    else
+    {
+	r = __malloc_sbrk_chunk(alloc_size, clean);
+	if (r == NULL)
+	{
+	    MALLOC_UNLOCK;
+	    return NULL;
+	}
+    }
+
+    rem = _size(r) - alloc_size;
+    if (rem >= MALLOC_MINSIZE)
+    {
+	/* Split off the excess and return it to the free lists */
+	chunk_t *s = (chunk_t *)((char *)r + alloc_size);
+	_set_size(r, alloc_size);
+	_set_size(s, rem);
+	_set_footer(s);
+	_set_prev_free(chunk_after(s));
+	_free_list_insert(s);
+    }
+    else
+    {
+	_clear_prev_free(chunk_after(r));
+
+	/* The footer is not zero */
+	*clean = MIN(*clean, chunk_usable(r) - sizeof(size_t));
+    }
+
+    MALLOC_UNLOCK;
+
+    return r;
+}
+
+#else
+
+/*
+ * Algorithm:
+ *   Use sbrk() to obtain more memory and ensure the storage is
+ *   MALLOC_CHUNK_ALIGN aligned. Optimise for the case that it is
+ *   already aligned - only ask for extra padding after we know we
+ *   need it
+ */
+static void *
+__malloc_sbrk_aligned(size_t s)
+{
+    char *p, *align_p;
+
+    p = __malloc_sbrk(s);
 
     /* sbrk returns -1 if fail to allocate */
     if (p == (void *)-1)
@@ -122,30 +346,24 @@ __malloc_grow_chunk(chunk_t *c, size_t new_size)
     return false;
 }
 
-/** Function malloc
+/** Function __malloc_take_chunk
   * Algorithm:
   *   Walk through the free list to find the first match. If fails to find
-  *   one, call sbrk to allocate a new chunk_t.
+  *   one, call sbrk to allocate a new chunk_t. Set 'clean' to the
+  *   number of bytes at the start of the chunk which came from the
+  *   free list.
   */
-void *
-malloc(size_t s)
+static chunk_t *
+__malloc_take_chunk(size_t alloc_size, size_t *clean)
 {
     chunk_t **p, *r;
-    char * ptr;
-    size_t alloc_size;
-
-    if (s > MALLOC_MAXSIZE)
-    {
-        errno = ENOMEM;
-        return NULL;
-    }
-
-    alloc_size = chunk_size(s);
+    size_t walk = 0;
 
     MALLOC_LOCK;
 
     for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
     {
+	walk++;
         if (_size(r) >= alloc_size)
         {
 	    size_t rem = _size(r) - alloc_size;
@@ -172,16 +390,22 @@ malloc(size_t s)
 	    }
             break;
         }
-	if (!r->next && __malloc_grow_chunk(r, alloc_size))
+	if (!r->next)
 	{
-	    /* Grow the last chunk in memory to the requested size,
-	     * just return it
-	     */
-	    *p = r->next;
-	    break;
+	    *clean = chunk_usable(r);
+	    if (__malloc_grow_chunk(r, alloc_size))
+	    {
+		/* Grow the last chunk in memory to the requested size,
+		 * just return it
+		 */
+		*p = r->next;
+		break;
+	    }
 	}
     }
 
+    _malloc_count_walk(walk);
+
     /* Failed to find a appropriate chunk_t. Ask for more memory */
     if (r == NULL)
     {
@@ -190,23 +414,139 @@ malloc(size_t s)
         /* sbrk returns -1 if fail to allocate */
         if (blob == (void *)-1)
         {
-            errno = ENOMEM;
             MALLOC_UNLOCK;
             return NULL;
         }
         r = blob_to_chunk(blob);
         _set_size(r, alloc_size);
+        *clean = 0;
     }
 
     MALLOC_UNLOCK;
 
+    return r;
+}
+
+#endif
+
+#ifdef __NANO_MALLOC_THREAD_CACHE
+
+__THREAD_LOCAL struct malloc_cache __malloc_cache;
+
+/*
+ * Take a chunk of 'size' bytes from the thread cache. When the cache
+ * is empty, take MALLOC_CACHE_FILL chunks from the heap at once and
+ * keep all but the first. That one keeps any excess.
+ */
+static chunk_t *
+__malloc_cache_take(size_t bin, size_t *clean)
+{
+    struct malloc_cache *cache = &__malloc_cache;
+    size_t size = _cache_size(bin);
+    chunk_t *r, *c;
+    size_t r_size;
+    int i;
+
+    r = cache->bins[bin];
+    if (r)
+    {
+	cache->bins[bin] = r->next;
+	cache->count[bin]--;
+	return r;
+    }
+
+    r = __malloc_take_chunk(size * MALLOC_CACHE_FILL, clean);
+    if (r == NULL)
+	return __malloc_take_chunk(size, clean);
+
+    r_size = _size(r) - size * (MALLOC_CACHE_FILL - 1);
+    *_size_ref(r) -= size * (MALLOC_CACHE_FILL - 1);
+    for (i = 0; i < MALLOC_CACHE_FILL - 1; i++)
+    {
+	c = (chunk_t *) ((char *) r + r_size + i * size);
+	_set_size(c, size);
+#ifdef __NANO_MALLOC_CLEAR_FREED
+	memset(c, 0, chunk_usable(c));
+#endif
+	c->next = cache->bins[bin];
+	cache->bins[bin] = c;
+	cache->count[bin]++;
+    }
+    return r;
+}
+
+#endif
+
+/** Function __malloc_alloc
+  * Algorithm:
+  *   Take a chunk from the thread cache or the heap and clear any
+  *   of it which isn't already known to be zero.
+  */
+void *
+__malloc_alloc(size_t s, bool clear)
+{
+    chunk_t *r;
+    char * ptr;
+    size_t alloc_size;
+    size_t clean = SIZE_MAX;
+
+    _malloc_count_alloc(s);
+
+    if (s > MALLOC_MAXSIZE)
+    {
+        _malloc_count_failure();
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    alloc_size = chunk_size(s);
+
+#ifdef __NANO_MALLOC_THREAD_CACHE
+    size_t bin = _cache_bin(alloc_size);
+
+    if (bin < MALLOC_CACHE_BINS)
+    {
+	alloc_size = _cache_size(bin);
+	r = __malloc_cache_take(bin, &clean);
+    }
+    else
+#endif
+	r = __malloc_take_chunk(alloc_size, &clean);
+
+    if (r == NULL)
+    {
+        _malloc_count_failure();
+        errno = ENOMEM;
+        return NULL;
+    }
+
     ptr = chunk_to_ptr(r);
 
-    memset(ptr, '\0', alloc_size - MALLOC_HEAD);
+    if (clear)
+    {
+#ifdef __NANO_MALLOC_CLEAR_FREED
+	/* Free chunks are zero apart from the list links */
+	memset(r, '\0', sizeof(chunk_t));
+#else
+	clean = 0;
+#endif
+	if (clean < alloc_size - MALLOC_HEAD)
+	    memset(ptr + clean, '\0', alloc_size - MALLOC_HEAD - clean);
+    }
 
     return ptr;
 }
 
+void *
+malloc(size_t s)
+{
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+    return __malloc_alloc(s, true);
+#else
+    return __malloc_alloc(s, false);
+#endif
+}
+
 #ifdef __strong_reference
 #if defined(__GNUCLIKE_PRAGMA_DIAGNOSTIC) && !defined(__clang__)
 #pragma GCC diagnostic ignored "-Wmissing-attributes"
@@ -228,6 +568,32 @@ __malloc_validate_block(chunk_t *r)
     assert (__align_up(_size(r), MALLOC_HEAD_ALIGN) == _size(r));
 }
 
+#ifdef __NANO_MALLOC_TLSF
+void
+__malloc_validate(void)
+{
+    chunk_t *r;
+    int fl, sl;
+
+    for (fl = 0; fl < (int) MALLOC_FL; fl++) {
+	assert (!(__malloc_fl_map & ((size_t) 1 << fl)) == !__malloc_sl_map[fl]);
+	for (sl = 0; sl < MALLOC_SL; sl++) {
+	    assert (!(__malloc_sl_map[fl] & (1 << sl)) == !__malloc_free_lists[fl][sl]);
+	    for (r = __malloc_free_lists[fl][sl]; r; r = r->next) {
+		int rfl, rsl;
+		__malloc_validate_block(r);
+		(void) _free_list_head(_size(r), &rfl, &rsl);
+		assert (rfl == fl && rsl == sl);
+		assert (r->next == NULL || r->next->prev == r);
+		assert (!_prev_free(r));
+		assert (_prev_free(chunk_after(r)));
+		assert (((size_t *) chunk_end(r))[-1] == _size(r));
+		assert (!chunk_is_free(chunk_after(r)));
+	    }
+	}
+    }
+}
+#else
 void
 __malloc_validate(void)
 {
@@ -238,5 +604,6 @@ __malloc_validate(void)
 	assert (r->next == NULL || (char *) r + _size(r) <= (char *) r->next);
     }
 }
+#endif
 
 #endif
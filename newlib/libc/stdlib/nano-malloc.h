@@ -45,8 +45,6 @@
 #include <stdint.h>
 
 #if MALLOC_DEBUG
-void __malloc_validate(void);
-void __malloc_validate_block(chunk_t *r);
 #define MALLOC_LOCK do { __LIBC_LOCK(); __malloc_validate(); } while(0)
 #define MALLOC_UNLOCK do { __malloc_validate(); __LIBC_UNLOCK(); } while(0)
 #else
@@ -93,8 +91,37 @@ typedef struct malloc_head {
 
 typedef struct malloc_chunk {
     struct malloc_chunk *next;
+#ifdef __NANO_MALLOC_TLSF
+    struct malloc_chunk *prev;
+#endif
 } chunk_t;
 
+#ifdef __NANO_MALLOC_TLSF
+/*
+ * With __NANO_MALLOC_TLSF, free chunks are kept in segregated,
+ * doubly-linked lists selected by a two-level size class so that
+ * malloc and free run in constant time:
+ *
+ *          --------------------------------------
+ *          | size | MALLOC_PREV_FREE            |
+ *   chunk->| next                               |
+ *          | prev                               |
+ *          | ...                                |
+ *          | size (footer)                      |
+ *          --------------------------------------
+ *
+ * The header is still a single size_t. Sizes are always a multiple
+ * of MALLOC_HEAD_ALIGN, so the low bit is used to mark chunks
+ * preceded by a free chunk; the footer of that free chunk locates
+ * its start for coalescing. Whether a chunk is free is recorded in
+ * the following chunk. Each region obtained from sbrk ends with a
+ * zero-sized header so the last chunk always has a successor.
+ */
+#define MALLOC_PREV_FREE	((size_t) 1)
+#else
+#define MALLOC_PREV_FREE	((size_t) 0)
+#endif
+
 /* Alignment of allocated chunk. Compute the alignment required from a
  * range of types */
 #define MALLOC_CHUNK_ALIGN	_Alignof(align_chunk_t)
@@ -111,7 +138,11 @@ typedef struct malloc_chunk {
 #define MALLOC_PAGE_ALIGN 	(0x1000)
 
 /* Minimum allocation size */
+#ifdef __NANO_MALLOC_TLSF
+#define MALLOC_MINSIZE		__align_up(MALLOC_HEAD + sizeof(chunk_t) + sizeof(size_t), MALLOC_HEAD_ALIGN)
+#else
 #define MALLOC_MINSIZE		__align_up(MALLOC_HEAD + sizeof(chunk_t), MALLOC_HEAD_ALIGN)
+#endif
 
 /* Maximum allocation size */
 #define MALLOC_MAXSIZE 		(SIZE_MAX - (MALLOC_HEAD + 2*MALLOC_CHUNK_ALIGN))
@@ -123,7 +154,7 @@ static inline size_t *_size_ref(chunk_t *chunk)
 
 static inline size_t _size(chunk_t *chunk)
 {
-    return *_size_ref(chunk);
+    return *_size_ref(chunk) & ~MALLOC_PREV_FREE;
 }
 
 static inline void _set_size(chunk_t *chunk, size_t size)
@@ -132,16 +163,146 @@ static inline void _set_size(chunk_t *chunk, size_t size)
 }
 
 /* Forward data declarations */
+#ifdef __NANO_MALLOC_TLSF
+
+/* Number of second-level classes per power of two, as log2 */
+#define MALLOC_SL_LOG2		2
+#define MALLOC_SL		(1 << MALLOC_SL_LOG2)
+
+/* Number of first-level classes */
+#define MALLOC_FL		(sizeof(size_t) * 8 - MALLOC_SL_LOG2)
+
+extern size_t __malloc_fl_map;
+extern uint8_t __malloc_sl_map[MALLOC_FL];
+extern chunk_t *__malloc_free_lists[MALLOC_FL][MALLOC_SL];
+#else
 extern chunk_t *__malloc_free_list;
+#endif
 extern char * __malloc_sbrk_start;
 extern char * __malloc_sbrk_top;
 
 #if MALLOC_DEBUG
-#else
+void __malloc_validate(void);
+void __malloc_validate_block(chunk_t *r);
 #endif
 
 bool __malloc_grow_chunk(chunk_t *c, size_t new_size);
 
+/* Allocate 's' bytes, setting them to zero if 'clear' is true */
+void *__malloc_alloc(size_t s, bool clear);
+
+/* Index of the most significant bit set in 's', which must not be zero */
+static inline int
+_malloc_log2(size_t s)
+{
+    if (sizeof(size_t) <= sizeof(unsigned int))
+        return (int) (sizeof(unsigned int) * 8 - 1) - __builtin_clz(s);
+    if (sizeof(size_t) <= sizeof(unsigned long))
+        return (int) (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(s);
+    return (int) (sizeof(unsigned long long) * 8 - 1) - __builtin_clzll(s);
+}
+
+#ifdef __NANO_MALLOC_INSTRUMENT
+/*
+ * With __NANO_MALLOC_INSTRUMENT, count calls, requested sizes and
+ * the number of free chunks inspected to satisfy each request. The
+ * walk counts are only updated with the malloc lock held. The call
+ * counts are also updated outside of it, by the thread cache and on
+ * entry to malloc and free, so those use atomic adds where the target
+ * has them and take the lock otherwise.
+ */
+extern struct malloc_instrument __malloc_counts;
+
+#if (__SIZEOF_SIZE_T__ == 4 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)) || \
+    (__SIZEOF_SIZE_T__ == 8 && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_8))
+#define _malloc_count_inc(c) __atomic_fetch_add(&(c), 1, __ATOMIC_RELAXED)
+#else
+#define _malloc_count_inc(c) do { __LIBC_LOCK(); (c)++; __LIBC_UNLOCK(); } while(0)
+#endif
+#endif
+
+static inline void
+_malloc_count_alloc(size_t s)
+{
+#ifdef __NANO_MALLOC_INSTRUMENT
+    int bin = s < 16 ? 0 : _malloc_log2(s) - 3;
+
+    if (bin >= MALLOC_HISTOGRAM_BINS)
+        bin = MALLOC_HISTOGRAM_BINS - 1;
+    _malloc_count_inc(__malloc_counts.alloc_calls);
+    _malloc_count_inc(__malloc_counts.size_histogram[bin]);
+#else
+    (void) s;
+#endif
+}
+
+static inline void
+_malloc_count_failure(void)
+{
+#ifdef __NANO_MALLOC_INSTRUMENT
+    _malloc_count_inc(__malloc_counts.alloc_failures);
+#endif
+}
+
+static inline void
+_malloc_count_free(void)
+{
+#ifdef __NANO_MALLOC_INSTRUMENT
+    _malloc_count_inc(__malloc_counts.free_calls);
+#endif
+}
+
+/* Record the free chunks inspected by one allocation. Called with
+ * the malloc lock held */
+static inline void
+_malloc_count_walk(size_t walk)
+{
+#ifdef __NANO_MALLOC_INSTRUMENT
+    __malloc_counts.walk_total += walk;
+    if (walk > __malloc_counts.walk_max)
+        __malloc_counts.walk_max = walk;
+#else
+    (void) walk;
+#endif
+}
+
+#ifdef __NANO_MALLOC_THREAD_CACHE
+/*
+ * With __NANO_MALLOC_THREAD_CACHE, each thread holds freed chunks of
+ * the smallest sizes in a thread-local cache, one list per size, so
+ * that most malloc and free calls for small objects don't take the
+ * lock. Chunks are taken from the heap MALLOC_CACHE_FILL at a time
+ * and returned MALLOC_CACHE_MAX / 2 at a time.
+ */
+#define MALLOC_CACHE_BINS	8
+#define MALLOC_CACHE_MAX	16
+#define MALLOC_CACHE_FILL	4
+
+struct malloc_cache {
+    chunk_t     *bins[MALLOC_CACHE_BINS];
+    uint8_t     count[MALLOC_CACHE_BINS];
+};
+
+extern __THREAD_LOCAL struct malloc_cache __malloc_cache;
+
+/* cache bin holding chunks of 'size' bytes */
+static inline size_t
+_cache_bin(size_t size)
+{
+    return (size - 1) / MALLOC_CHUNK_ALIGN;
+}
+
+/* size of the chunks held in a cache bin */
+static inline size_t
+_cache_size(size_t bin)
+{
+    return (bin + 1) * MALLOC_CHUNK_ALIGN;
+}
+
+/* Return up to 'count' chunks from a cache bin to the heap */
+void __malloc_cache_flush(size_t bin, size_t count);
+#endif
+
 /* Work around compiler optimizing away stores to 'size' field before
  * call to free.
  */
@@ -185,8 +346,7 @@ chunk_to_blob(chunk_t *c)
 static inline void *
 chunk_end(chunk_t *c)
 {
-    size_t *s = _size_ref(c);
-    return (char *) s + *s;
+    return (char *) _size_ref(c) + _size(c);
 }
 
 /* next chunk in memory -- address of chunk header past this chunk */
@@ -222,10 +382,108 @@ chunk_usable(chunk_t *c)
 }
 
 /* assign 'size' to the specified chunk and return it to the free
- * pool */
+ * pool. The chunk must not be preceded by a free chunk */
 static inline void
 make_free_chunk(chunk_t *c, size_t size)
 {
     _set_size(c, size);
     __malloc_free(chunk_to_ptr(c));
 }
+
+#ifdef __NANO_MALLOC_TLSF
+
+static inline bool
+_prev_free(chunk_t *c)
+{
+    return (*_size_ref(c) & MALLOC_PREV_FREE) != 0;
+}
+
+static inline void
+_set_prev_free(chunk_t *c)
+{
+    *_size_ref(c) |= MALLOC_PREV_FREE;
+}
+
+static inline void
+_clear_prev_free(chunk_t *c)
+{
+    *_size_ref(c) &= ~MALLOC_PREV_FREE;
+}
+
+/* store the size of a free chunk in its last word */
+static inline void
+_set_footer(chunk_t *c)
+{
+    ((size_t *) chunk_end(c))[-1] = _size(c);
+}
+
+/* previous chunk in memory, only valid when it is free */
+static inline chunk_t *
+chunk_before(chunk_t *c)
+{
+    return (chunk_t *) ((char *) c - ((size_t *) _size_ref(c))[-1]);
+}
+
+/* whether the chunk is in the free lists */
+static inline bool
+chunk_is_free(chunk_t *c)
+{
+    return _size(c) != 0 && _prev_free(chunk_after(c));
+}
+
+static inline int
+_malloc_ffs(size_t s)
+{
+    if (sizeof(size_t) <= sizeof(unsigned int))
+        return __builtin_ctz(s);
+    if (sizeof(size_t) <= sizeof(unsigned long))
+        return __builtin_ctzl(s);
+    return __builtin_ctzll(s);
+}
+
+/*
+ * Map a size to its free list. The first level is the power of two
+ * below 'size', the second level splits that range into MALLOC_SL
+ * equal pieces.
+ */
+static inline chunk_t **
+_free_list_head(size_t size, int *fl, int *sl)
+{
+    *fl = _malloc_log2(size) - MALLOC_SL_LOG2;
+    *sl = (int) (size >> *fl) & (MALLOC_SL - 1);
+    return &__malloc_free_lists[*fl][*sl];
+}
+
+static inline void
+_free_list_insert(chunk_t *c)
+{
+    int fl, sl;
+    chunk_t **head = _free_list_head(_size(c), &fl, &sl);
+
+    c->prev = NULL;
+    c->next = *head;
+    if (c->next)
+        c->next->prev = c;
+    *head = c;
+    __malloc_fl_map |= (size_t) 1 << fl;
+    __malloc_sl_map[fl] |= 1 << sl;
+}
+
+static inline void
+_free_list_remove(chunk_t *c)
+{
+    int fl, sl;
+    chunk_t **head = _free_list_head(_size(c), &fl, &sl);
+
+    if (c->next)
+        c->next->prev = c->prev;
+    if (c->prev)
+        c->prev->next = c->next;
+    else if ((*head = c->next) == NULL) {
+        __malloc_sl_map[fl] &= ~(1 << sl);
+        if (!__malloc_sl_map[fl])
+            __malloc_fl_map &= ~((size_t) 1 << fl);
+    }
+}
+
+#endif
@@ -91,7 +91,10 @@ memalign(size_t align, size_t s)
 	chunk_t *new_chunk_p = ptr_to_chunk(aligned_p);
 	_set_size(new_chunk_p, _size(chunk_p) - offset);
 
-	make_free_chunk(chunk_p, offset);
+	/* Keep the header flags; a chunk from the thread cache
+	 * may follow a free chunk */
+	*_size_ref(chunk_p) -= _size(new_chunk_p);
+	__malloc_free(chunk_to_ptr(chunk_p));
 
 	chunk_p = new_chunk_p;
     }
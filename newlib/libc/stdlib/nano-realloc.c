@@ -66,43 +66,72 @@ realloc(void * ptr, size_t size)
      */
     if (new_size > old_size)
     {
-	void *chunk_e = chunk_end(p_to_realloc);
-
 	MALLOC_LOCK;
 
-	if (__malloc_grow_chunk(p_to_realloc, new_size))
+#ifdef __NANO_MALLOC_TLSF
+	chunk_t *r = chunk_after(p_to_realloc);
+
+	/* Merge in a free chunk just past the current block */
+	if (chunk_is_free(r))
 	{
-	    /* clear new memory */
-	    memset(chunk_e, '\0', new_size - old_size);
-	    /* adjust chunk_t size */
-	    old_size = new_size;
+	    size_t r_size = _size(r);
+
+	    _free_list_remove(r);
+	    _clear_prev_free(chunk_after(r));
+
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+	    /* clear the memory from r, including its header */
+	    memset(chunk_end(p_to_realloc), '\0', r_size);
+#endif
+
+	    /* add it's size to our block */
+	    old_size += r_size;
+	    *_size_ref(p_to_realloc) += r_size;
 	}
-	else
+#else
+	chunk_t **p, *r;
+	chunk_t *next = chunk_after(p_to_realloc);
+
+	/* Check to see if there's a chunk_t of free space just past
+	 * the current block, merge it in in case that's useful
+	 */
+	for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
 	{
-	    chunk_t **p, *r;
+	    if (r == next)
+	    {
+		size_t r_size = _size(r);
+
+		/* remove R from the free list */
+		*p = r->next;
 
-	    /* Check to see if there's a chunk_t of free space just past
-	     * the current block, merge it in in case that's useful
-	     */
-	    for (p = &__malloc_free_list; (r = *p) != NULL; p = &r->next)
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+		/* clear the memory from r, including its header */
+		memset(chunk_end(p_to_realloc), '\0', r_size);
+#endif
+
+		/* add it's size to our block */
+		old_size += r_size;
+		_set_size(p_to_realloc, old_size);
+		break;
+	    }
+	    if (next < r)
+		break;
+	}
+#endif
+
+	/* If the block is now at the top of the heap, extend the heap */
+	if (new_size > old_size)
+	{
+	    if (__malloc_grow_chunk(p_to_realloc, new_size))
 	    {
-		if (r == chunk_e)
-		{
-		    size_t r_size = _size(r);
-
-		    /* remove R from the free list */
-		    *p = r->next;
-
-		    /* clear the memory from r */
-		    memset(r, '\0', r_size);
-
-		    /* add it's size to our block */
-		    old_size += r_size;
-		    _set_size(p_to_realloc, old_size);
-		    break;
-		}
-		if (p_to_realloc < r)
-		    break;
+		size_t grown_size = _size(p_to_realloc);
+
+#ifdef __NANO_MALLOC_CLEAR_ALLOCATED
+		/* clear new memory */
+		memset((char *) ptr + old_size - MALLOC_HEAD, '\0', grown_size - old_size);
+#endif
+		/* adjust chunk_t size */
+		old_size = grown_size;
 	    }
 	}
 
@@ -121,7 +150,7 @@ realloc(void * ptr, size_t size)
 	 * and free it
 	 */
 	if (extra >= MALLOC_MINSIZE) {
-	    _set_size(p_to_realloc, new_size);
+	    *_size_ref(p_to_realloc) -= extra;
 	    make_free_chunk(chunk_after(p_to_realloc), extra);
 	}
 	return ptr;
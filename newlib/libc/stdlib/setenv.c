@@ -36,6 +36,8 @@ extern char **environ;
    'environ'.  */
 static char ***p_environ = &environ;
 
+unsigned int __env_generation;
+
 int
 setenv (const char *name,
 	const char *value,
@@ -55,6 +57,8 @@ setenv (const char *name,
 
   ENV_LOCK;
 
+  __env_generation++;
+
   l_value = strlen (value);
   if ((C = _findenv (name, &offset)))
     {				/* find if already exists */
@@ -136,6 +140,8 @@ unsetenv (const char *name)
 
   ENV_LOCK;
 
+  __env_generation++;
+
   while (_findenv (name, &offset))	/* if set multiple times */
     { 
       for (P = &(*p_environ)[offset];; ++P)
@@ -180,8 +180,8 @@ __ucs4_wctomb (
     uint32_t    uchar = (uint32_t) wchar;
 
     (void) state;
-    /* Surrogates are invalid in UCS-4 */
-    if (wchar >= 0xd800 && wchar <= 0xdfff)
+    /* Surrogates and values beyond Unicode are invalid in UCS-4 */
+    if ((wchar >= 0xd800 && wchar <= 0xdfff) || (uint32_t) wchar > 0x10ffff)
         return -1;
 
     memcpy((void *) s, &uchar, 4);
@@ -197,8 +197,8 @@ __ucs4swap_wctomb (
     uint32_t    uchar = __bswap32((uint32_t) wchar);
 
     (void) state;
-    /* Surrogates are invalid in UCS-4 */
-    if (wchar >= 0xd800 && wchar <= 0xdfff)
+    /* Surrogates and values beyond Unicode are invalid in UCS-4 */
+    if ((wchar >= 0xd800 && wchar <= 0xdfff) || (uint32_t) wchar > 0x10ffff)
         return -1;
 
     memcpy((void *) s, &uchar, 4);
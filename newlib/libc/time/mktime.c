@@ -88,6 +88,46 @@ static const int16_t _DAYS_BEFORE_MONTH[12] =
 
 #define _DAYS_IN_YEAR(year) (isleap(year+YEAR_BASE) ? 366 : 365)
 
+/* The calendar repeats every 400 years */
+#define YEARS_PER_ERA		400
+#define DAYS_PER_ERA		146097
+/* Days from 01.03.0000 to 01.01.1970 */
+#define EPOCH_ADJUSTMENT_DAYS	719468L
+
+/* Days from 01.01.1970 to the first day of month 'mon' in 'year'.
+ * Years are counted from March so that the leap day comes last. See
+ * http://howardhinnant.github.io/date_algorithms.html#days_from_civil */
+static long
+days_from_civil (long year, int mon)
+{
+  long era, erayear, yearday;
+
+  if (mon < 2)
+    year--;
+  era = (year >= 0 ? year : year - (YEARS_PER_ERA - 1)) / YEARS_PER_ERA;
+  erayear = year - era * YEARS_PER_ERA;				/* [0, 399] */
+  yearday = (153 * (mon < 2 ? mon + 10 : mon - 2) + 2) / 5;	/* [0, 306] */
+  return era * DAYS_PER_ERA + erayear * 365 + erayear / 4 - erayear / 100 +
+    yearday - EPOCH_ADJUSTMENT_DAYS;
+}
+
+/* The inverse of days_from_civil, setting year, month and day */
+static void
+civil_from_days (long days, struct tm *tim_p)
+{
+  long era, eraday, erayear, yearday, month;
+
+  days += EPOCH_ADJUSTMENT_DAYS;
+  era = (days >= 0 ? days : days - (DAYS_PER_ERA - 1)) / DAYS_PER_ERA;
+  eraday = days - era * DAYS_PER_ERA;				/* [0, 146096] */
+  erayear = (eraday - eraday / 1460 + eraday / 36524 - eraday / 146096) / 365;
+  yearday = eraday - (365 * erayear + erayear / 4 - erayear / 100);
+  month = (5 * yearday + 2) / 153;				/* [0, 11] */
+  tim_p->tm_mday = yearday - (153 * month + 2) / 5 + 1;
+  tim_p->tm_mon = month < 10 ? month + 2 : month - 10;
+  tim_p->tm_year = erayear + era * YEARS_PER_ERA + (tim_p->tm_mon <= 1) - YEAR_BASE;
+}
+
 static void
 set_tm_wday (long days, struct tm *tim_p)
 {
@@ -149,35 +189,21 @@ validate_structure (struct tm *tim_p)
   if (isleap (tim_p->tm_year+YEAR_BASE))
     days_in_feb = 29;
 
-  if (tim_p->tm_mday <= 0)
-    {
-      while (tim_p->tm_mday <= 0)
-	{
-	  if (--tim_p->tm_mon == -1)
-	    {
-	      tim_p->tm_year--;
-	      tim_p->tm_mon = 11;
-	      days_in_feb =
-		(isleap (tim_p->tm_year+YEAR_BASE) ?
-		 29 : 28);
-	    }
-	  tim_p->tm_mday += _DAYS_IN_MONTH (tim_p->tm_mon);
-	}
-    }
-  else
+  if (tim_p->tm_mday <= 0 || tim_p->tm_mday > _DAYS_IN_MONTH (tim_p->tm_mon))
     {
-      while (tim_p->tm_mday > _DAYS_IN_MONTH (tim_p->tm_mon))
-	{
-	  tim_p->tm_mday -= _DAYS_IN_MONTH (tim_p->tm_mon);
-	  if (++tim_p->tm_mon == 12)
-	    {
-	      tim_p->tm_year++;
-	      tim_p->tm_mon = 0;
-	      days_in_feb =
-		(isleap (tim_p->tm_year+YEAR_BASE) ?
-		 29 : 28);
-	    }
-	}
+      int eras;
+
+      /* move whole 400 year eras from the day to the year, then
+	 shift the year into [0, 399] so the day count stays small */
+      res = div (tim_p->tm_mday, DAYS_PER_ERA);
+      tim_p->tm_year += res.quot * YEARS_PER_ERA;
+      eras = tim_p->tm_year / YEARS_PER_ERA;
+      if (tim_p->tm_year % YEARS_PER_ERA < 0)
+	eras--;
+      civil_from_days (days_from_civil (tim_p->tm_year - eras * YEARS_PER_ERA + YEAR_BASE,
+					tim_p->tm_mon) + res.rem - 1,
+		       tim_p);
+      tim_p->tm_year += eras * YEARS_PER_ERA;
     }
 }
 
@@ -186,7 +212,6 @@ mktime_utc (struct tm *tim_p, long *days_p)
 {
   time_t tim = 0;
   long days = 0;
-  int year;
 
   /* validate structure */
   validate_structure (tim_p);
@@ -208,17 +233,7 @@ mktime_utc (struct tm *tim_p, long *days_p)
       return (time_t) -1;
 
   /* compute days in other years */
-  if ((year = tim_p->tm_year) > 70)
-    {
-      for (year = 70; year < tim_p->tm_year; year++)
-	days += _DAYS_IN_YEAR (year);
-    }
-  else if (year < 70)
-    {
-      for (year = 69; year > tim_p->tm_year; year--)
-	days -= _DAYS_IN_YEAR (year);
-      days -= _DAYS_IN_YEAR (year);
-    }
+  days += days_from_civil (tim_p->tm_year + YEAR_BASE, 0);
 
   /* compute total seconds */
   tim += (time_t)days * SECSPERDAY;
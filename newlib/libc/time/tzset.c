@@ -89,6 +89,10 @@ Note that there is no white-space padding between fields. Also note that
 if <[TZ]> is null, the default is Universal Time which has no daylight saving
 time. If <[TZ]> is empty, the default EST5EDT is used.
 
+The parsed value is kept and used by <<localtime>>, <<mktime>> and
+<<strftime>> until <[TZ]> is changed with <<setenv>>, <<putenv>> or
+<<unsetenv>>. Calling <<tzset>> always examines <[TZ]> again.
+
 RETURNS
 There is no return value.
 
@@ -105,6 +109,7 @@ Supporting OS subroutine required: None
 #include <sys/types.h>
 #include <time.h>
 #include <limits.h>
+#include <stdbool.h>
 #include "local.h"
 
 #define TZNAME_MIN	3	/* POSIX min TZ abbr size local def */
@@ -112,6 +117,20 @@ Supporting OS subroutine required: None
 static char __tzname_std[TZNAME_MAX + 2];
 static char __tzname_dst[TZNAME_MAX + 2];
 
+/* Environment generation when TZ was last parsed. The reference is weak
+   so that TZ parsing doesn't pull in setenv */
+extern unsigned int __env_generation __weak;
+static unsigned int tz_generation;
+static bool tz_parsed;
+
+static unsigned int
+env_generation (void)
+{
+  if (&__env_generation)
+    return __env_generation;
+  return 0;
+}
+
 void
 _tzset_unlocked (void)
 {
@@ -123,6 +142,13 @@ _tzset_unlocked (void)
   __tzinfo_type *tz = __gettzinfo ();
   static const struct __tzrule_struct default_tzrule = {'J', 0, 0, 0, 0, (time_t)0, 0L };
 
+  /* nothing to do if TZ hasn't changed since it was parsed */
+  if (tz_parsed && tz_generation == env_generation ())
+    return;
+
+  tz_parsed = true;
+  tz_generation = env_generation ();
+
   if ((tzenv = getenv ("TZ")) == NULL)
       {
 	_timezone = 0;
@@ -341,6 +367,7 @@ void
 tzset (void)
 {
   TZ_LOCK;
+  tz_parsed = false;
   _tzset_unlocked ();
   TZ_UNLOCK;
 }
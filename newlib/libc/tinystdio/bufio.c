@@ -47,6 +47,97 @@ __bufio_lock_init(FILE *f)
 }
 #endif
 
+#ifdef __BUFIO_BATCH_FLUSH
+/*
+ * Streams which have been written to, flushed by fflush(NULL).
+ *
+ * The list links are only changed with the libc lock held, which is
+ * never held while taking any other lock. Streams are added from put
+ * and write, which may hold the stream's lock, so that is all they
+ * take. Flushing the list takes each stream's lock in turn, so it
+ * holds the flush lock instead, which keeps streams from being
+ * removed and freed by close while they are being flushed. Lock
+ * order is flush lock, then stream lock, then libc lock.
+ */
+static struct __file_bufio *__bufio_streams;
+
+#ifndef __SINGLE_THREAD
+static _LOCK_T __bufio_flush_lock;
+
+static void
+__bufio_flush_lock_acquire(void)
+{
+        __LIBC_LOCK();
+        if (!__bufio_flush_lock)
+                __lock_init(__bufio_flush_lock);
+        __LIBC_UNLOCK();
+        __lock_acquire(__bufio_flush_lock);
+}
+
+#define __bufio_flush_lock_release() __lock_release(__bufio_flush_lock)
+#else
+#define __bufio_flush_lock_acquire()
+#define __bufio_flush_lock_release()
+#endif
+
+static void
+__bufio_list(FILE *f)
+{
+        struct __file_bufio *bf = (struct __file_bufio *) f;
+
+        __LIBC_LOCK();
+        if (!bf->listed) {
+                bf->next = __bufio_streams;
+                __bufio_streams = bf;
+                bf->listed = 1;
+        }
+        __LIBC_UNLOCK();
+}
+
+static void
+__bufio_unlist(FILE *f)
+{
+        struct __file_bufio *bf = (struct __file_bufio *) f;
+        struct __file_bufio **prev;
+
+        __bufio_flush_lock_acquire();
+        __LIBC_LOCK();
+        if (bf->listed) {
+                for (prev = &__bufio_streams; *prev != bf; prev = &(*prev)->next)
+                        ;
+                *prev = bf->next;
+                bf->listed = 0;
+        }
+        __LIBC_UNLOCK();
+        __bufio_flush_lock_release();
+}
+
+/*
+ * Flush every stream with pending output. This is called when
+ * reading stdin and from fflush(NULL), letting applications hold
+ * output from several streams until a single point.
+ */
+int
+__bufio_flush_all(void)
+{
+        struct __file_bufio *bf;
+        int ret = 0;
+
+        __bufio_flush_lock_acquire();
+        /* Streams are only added at the head, so once it has been
+         * read the rest of the list stays put until the flush lock
+         * is released */
+        __LIBC_LOCK();
+        bf = __bufio_streams;
+        __LIBC_UNLOCK();
+        for (; bf; bf = bf->next)
+                if (fflush(&bf->xfile.cfile.file) < 0)
+                        ret = _FDEV_ERR;
+        __bufio_flush_lock_release();
+        return ret;
+}
+#endif
+
 int
 __bufio_flush_locked(FILE *f)
 {
@@ -141,6 +232,10 @@ __bufio_put(char c, FILE *f)
 	struct __file_bufio *bf = (struct __file_bufio *) f;
         int ret = (unsigned char) c;
 
+#ifdef __BUFIO_BATCH_FLUSH
+        if (!bf->listed)
+                __bufio_list(f);
+#endif
 	__bufio_lock(f);
         if (__bufio_setdir_locked(f, __SWR) < 0) {
                 ret = _FDEV_ERR;
@@ -159,6 +254,91 @@ bail:
 	return ret;
 }
 
+ssize_t
+__bufio_write(const char *buf, size_t len, FILE *f)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        const char *cp = buf;
+
+#ifdef __BUFIO_BATCH_FLUSH
+        if (!bf->listed)
+                __bufio_list(f);
+#endif
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SWR) < 0)
+                goto bail;
+
+        if (len >= (size_t) bf->size) {
+                /*
+                 * Large writes go direct. Any pending data are sent
+                 * in the same call when the stream has writev,
+                 * otherwise they are flushed first.
+                 */
+                if (bf->len && bufio_has_writev(bf)) {
+                        char *pending = bf->buf;
+                        struct iovec iov[2];
+
+                        while (bf->len) {
+                                ssize_t this;
+
+                                iov[0].iov_base = pending;
+                                iov[0].iov_len = bf->len;
+                                iov[1].iov_base = (void *) cp;
+                                iov[1].iov_len = len;
+                                this = bufio_writev(bf, iov, 2);
+                                if (this <= 0) {
+                                        bf->len = 0;
+                                        goto bail;
+                                }
+                                bf->pos += this;
+                                if (this < bf->len) {
+                                        pending += this;
+                                        bf->len -= this;
+                                } else {
+                                        this -= bf->len;
+                                        bf->len = 0;
+                                        cp += this;
+                                        len -= this;
+                                }
+                        }
+                } else if (__bufio_flush_locked(f) < 0) {
+                        goto bail;
+                }
+                while (len) {
+                        ssize_t this = bufio_write(bf, cp, len);
+                        if (this <= 0)
+                                goto bail;
+                        cp += this;
+                        bf->pos += this;
+                        len -= this;
+                }
+                goto bail;
+        }
+
+        while (len) {
+                size_t this = bf->size - bf->len;
+                if (this > len)
+                        this = len;
+                memcpy(bf->buf + bf->len, cp, this);
+                bf->len += this;
+                cp += this;
+                len -= this;
+
+                /* flush if full */
+                if (bf->len >= bf->size)
+                        if (__bufio_flush_locked(f) < 0)
+                                goto bail;
+        }
+
+        /* flush if sending a newline when linebuffered */
+	if ((bf->bflags & __BLBF) && bf->len && memchr(buf, '\n', cp - buf))
+                (void) __bufio_flush_locked(f);
+
+bail:
+	__bufio_unlock(f);
+	return cp - buf;
+}
+
 extern FILE *const stdin __weak;
 extern FILE *const stdout __weak;
 
@@ -190,7 +370,11 @@ again:
                         flushed = true;
                         if (&stdin != NULL && &stdout != NULL && f == stdin) {
                                 __bufio_unlock(f);
+#ifdef __BUFIO_BATCH_FLUSH
+                                __bufio_flush_all();
+#else
                                 fflush(stdout);
+#endif
                                 goto again;
                         }
 		}
@@ -210,6 +394,62 @@ bail:
 	return ret;
 }
 
+/*
+ * Discard 'consume' chars from the front of the buffer, then return
+ * the buffered data, filling the buffer if it is empty. With a NULL
+ * 'buf', just discard chars without filling.
+ */
+ssize_t
+__bufio_peek(const char **buf, size_t consume, FILE *f)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        ssize_t ret;
+        bool flushed = false;
+
+again:
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SRD) < 0) {
+                ret = _FDEV_ERR;
+                goto bail;
+        }
+
+        if (consume > (size_t) (bf->len - bf->off))
+                consume = bf->len - bf->off;
+        bf->off += consume;
+
+        if (!buf) {
+                ret = 0;
+                goto bail;
+        }
+
+	if (bf->off >= bf->len) {
+
+                /* Flush stdout if reading from stdin, as in __bufio_get */
+                if (!flushed) {
+                        flushed = true;
+                        if (&stdin != NULL && &stdout != NULL && f == stdin) {
+                                __bufio_unlock(f);
+#ifdef __BUFIO_BATCH_FLUSH
+                                __bufio_flush_all();
+#else
+                                fflush(stdout);
+#endif
+                                goto again;
+                        }
+		}
+
+                ret = __bufio_fill_locked(f);
+                if (ret)
+                    goto bail;
+	}
+
+        *buf = bf->buf + bf->off;
+        ret = bf->len - bf->off;
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence)
 {
@@ -306,6 +546,9 @@ __bufio_close(FILE *f)
 	struct __file_bufio *bf = (struct __file_bufio *) f;
 	int ret = 0;
 
+#ifdef __BUFIO_BATCH_FLUSH
+        __bufio_unlist(f);
+#endif
 	__bufio_lock(f);
         ret = __bufio_flush_locked(f);
 
@@ -35,10 +35,34 @@
 
 #include "stdio_private.h"
 
+#ifdef __BUFIO_BATCH_FLUSH
+/* Weak so that fflush doesn't pull in bufio */
+extern int __bufio_flush_all(void) __weak;
+#else
+/* Weak so that fflush doesn't pull in stdout and stderr */
+extern FILE *const stdout __weak;
+extern FILE *const stderr __weak;
+#endif
+
 int
 fflush(FILE *stream)
 {
         int ret = 0;
+
+        if (stream == NULL) {
+#ifdef __BUFIO_BATCH_FLUSH
+                if (&__bufio_flush_all != NULL)
+                        ret = __bufio_flush_all();
+#else
+                /* Without the list of streams, flush the standard
+                 * output streams */
+                if (&stdout != NULL && fflush(stdout) < 0)
+                        ret = EOF;
+                if (&stderr != NULL && stderr != stdout && fflush(stderr) < 0)
+                        ret = EOF;
+#endif
+                return ret;
+        }
         __flockfile(stream);
 	if (stream->flush)
 		ret = (stream->flush)(stream);
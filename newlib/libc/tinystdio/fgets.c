@@ -36,20 +36,40 @@ fgets(char *str, int size, FILE *stream)
 {
 	char *cp;
 	int c;
+        const char *buf;
+        ssize_t len;
 
         __flockfile(stream);
 	if ((stream->flags & __SRD) == 0 || size <= 0)
 		__funlock_return(stream, NULL);
 
 	size--;
-	for (c = 0, cp = str; c != '\n' && size > 0; size--, cp++) {
-		if ((c = getc_unlocked(stream)) == EOF) {
+	for (c = 0, cp = str; c != '\n' && size > 0; ) {
+                len = __file_peek(&buf, stream);
+                if (len > 0) {
+                        /* Copy straight from the stream buffer */
+                        const char *nl;
+                        if (len > size)
+                                len = size;
+                        nl = memchr(buf, '\n', len);
+                        if (nl) {
+                                len = nl - buf + 1;
+                                c = '\n';
+                        }
+                        memcpy(cp, buf, len);
+                        __file_consume(len, stream);
+                        cp += len;
+                        size -= len;
+                        continue;
+                }
+		if (len < 0 || (c = getc_unlocked(stream)) == EOF) {
 			if(cp == str)
 				__funlock_return(stream, NULL);
 			else
 				break;
 		}
-		*cp = (char)c;
+		*cp++ = (char)c;
+                size--;
 	}
 	*cp = '\0';
 
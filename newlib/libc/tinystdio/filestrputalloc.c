@@ -42,8 +42,10 @@ __file_str_put_alloc(char c, FILE *stream)
 	if (sstream->pos == sstream->end) {
                 size_t old_size = sstream->size;
                 char *old = POINTER_MINUS(sstream->end, old_size);
-                size_t new_size = old_size + 32;
+                size_t new_size = old_size ? old_size * 2 : 32;
                 char *new;
+                if (new_size < old_size)
+                        return EOF;
                 if (sstream->alloc)
                         new = realloc(old, new_size);
                 else {
@@ -0,0 +1,71 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+
+ssize_t __disable_sanitizer
+__file_str_write_alloc(const char *buf, size_t len, FILE *stream)
+{
+	struct __file_str *sstream = (struct __file_str *) stream;
+	if ((size_t) (sstream->end - sstream->pos) < len) {
+                size_t old_size = sstream->size;
+                char *old = POINTER_MINUS(sstream->end, old_size);
+                size_t used = old_size - (sstream->end - sstream->pos);
+                size_t new_size = (used + len + 32) & ~(size_t) 31;
+                char *new;
+                if (new_size < used + len)
+                        return _FDEV_ERR;
+                /* Grow geometrically so that building a long string
+                 * doesn't copy it over and over */
+                if (new_size < old_size * 2 && old_size * 2 > old_size)
+                        new_size = old_size * 2;
+                if (sstream->alloc)
+                        new = realloc(old, new_size);
+                else {
+                        new = malloc(new_size);
+                        if (new && old_size)
+                                memcpy(new, old, old_size);
+                }
+		if (!new)
+			return _FDEV_ERR;
+		sstream->size = new_size;
+                sstream->pos = new + used;
+                sstream->end = new + new_size;
+                sstream->alloc = true;
+	}
+        memcpy(sstream->pos, buf, len);
+        sstream->pos += len;
+	return len;
+}
@@ -73,6 +73,27 @@ __fmem_put(char c, FILE *f)
     }
 }
 
+/* Copy spans directly into the buffer */
+static ssize_t
+__fmem_write(const char *buf, size_t len, FILE *f)
+{
+    struct __file_mem *mf = (struct __file_mem *)f;
+    size_t pos = mf->mflags & __MAPP ? mf->size : mf->pos;
+    if ((f->flags & __SWR) == 0)
+        return _FDEV_ERR;
+    if (len > mf->bufsize - pos)
+        len = mf->bufsize - pos;
+    memcpy(mf->buf + pos, buf, len);
+    pos += len;
+    if (pos > mf->size) {
+        mf->size = pos;
+        if (mf->size < mf->bufsize)
+            mf->buf[mf->size] = '\0';
+    }
+    mf->pos = pos;
+    return len;
+}
+
 static int
 __fmem_get(FILE *f)
 {
@@ -86,6 +107,26 @@ __fmem_get(FILE *f)
     }
 }
 
+/* Let readers see the rest of the buffer directly */
+static ssize_t
+__fmem_peek(const char **buf, size_t consume, FILE *f)
+{
+    struct __file_mem *mf = (struct __file_mem *)f;
+    size_t avail = mf->pos < mf->size ? mf->size - mf->pos : 0;
+    if ((f->flags & __SRD) == 0)
+        return _FDEV_ERR;
+    if (consume > avail)
+        consume = avail;
+    mf->pos += consume;
+    avail -= consume;
+    if (!buf)
+        return 0;
+    if (!avail)
+        return _FDEV_EOF;
+    *buf = mf->buf + mf->pos;
+    return avail;
+}
+
 static int
 __fmem_flush(FILE *f)
 {
@@ -192,8 +233,9 @@ fmemopen(void *buf, size_t size, const char *mode)
     }
 
     *mf = (struct __file_mem){
-        .xfile = FDEV_SETUP_EXT(__fmem_put, __fmem_get, __fmem_flush,
-                                __fmem_close, __fmem_seek, NULL, stdio_flags),
+        .xfile = __FDEV_SETUP_EXT(__fmem_put, __fmem_write, __fmem_get, __fmem_peek,
+                                  __fmem_flush, __fmem_close, __fmem_seek, NULL,
+                                  stdio_flags),
         .buf = buf,
         .size = initial_size,
         .bufsize = size,
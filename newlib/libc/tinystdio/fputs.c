@@ -34,21 +34,18 @@
 int
 fputs(const char *str, FILE *stream)
 {
-        int (*put)(char, struct __file *);
-	char c;
+        size_t len;
 	int ret = EOF;
 
 	__flockfile(stream);
 	if ((stream->flags & __SWR) == 0)
 		goto fail;
 
-        put = stream->put;
-
-	while ((c = *str++) != '\0')
-                if (put(c, stream) < 0) {
-                        stream->flags |= __SERR;
-			goto fail;
-                }
+        len = strlen(str);
+        if (__file_write(str, len, stream) != len) {
+                stream->flags |= __SERR;
+                goto fail;
+        }
 
 	ret = 0;
 fail:
@@ -30,10 +30,7 @@
 /* $Id: fread.c 1944 2009-04-01 23:12:20Z arcanum $ */
 
 #include "stdio_private.h"
-
-#ifdef __FAST_BUFIO
 #include "../stdlib/mul_overflow.h"
-#endif
 
 extern FILE *const stdin __weak;
 extern FILE *const stdout __weak;
@@ -49,8 +46,8 @@ fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
 	if ((stream->flags & __SRD) == 0 || size == 0)
 		__funlock_return(stream, 0);
 
-#ifdef __FAST_BUFIO
         size_t bytes;
+#ifdef __FAST_BUFIO
         if ((stream->flags & __SBUF) != 0 &&
             !mul_overflow(size, nmemb, &bytes) && bytes > 0)
         {
@@ -117,6 +114,34 @@ fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
                 __funlock_return(stream, (cp - (uint8_t *) ptr) / size);
         }
 #endif
+
+        /* Copy straight from streams which expose their buffer */
+        if (stream->peek && !mul_overflow(size, nmemb, &bytes)) {
+                __ungetc_t unget;
+
+                if (bytes && (unget = __atomic_exchange_ungetc(&stream->unget, 0)) != 0) {
+                        *cp++ = (unget - 1);
+                        bytes--;
+                }
+
+                while (bytes) {
+                        const char *buf;
+                        ssize_t len = stream->peek(&buf, 0, stream);
+
+                        if (len <= 0) {
+                                stream->flags |= (len == _FDEV_ERR) ? __SERR : __SEOF;
+                                break;
+                        }
+                        if ((size_t) len > bytes)
+                                len = bytes;
+                        memcpy(cp, buf, len);
+                        (void) stream->peek(NULL, len, stream);
+                        cp += len;
+                        bytes -= len;
+                }
+                __funlock_return(stream, (cp - (uint8_t *) ptr) / size);
+        }
+
 	for (i = 0; i < nmemb; i++)
 		for (j = 0; j < size; j++) {
 			c = getc_unlocked(stream);
@@ -73,6 +73,7 @@ freopen(const char *pathname, const char *mode, FILE *stream)
         /* Switch to POSIX backend */
         pf->read_int = read;
         pf->write_int = write;
+        pf->writev_int = writev;
         pf->lseek_int = lseek;
         pf->close_int = close;
 
@@ -44,10 +44,38 @@ getdelim (char **restrict lineptr, size_t *restrict nptr,
     char *line = *lineptr;
     size_t n = *nptr;
     _ssize_t count = 0;
+    const char *buf;
+    ssize_t len;
 
     __flockfile(stream);
     for (;;) {
-        int c = getc_unlocked(stream);
+        len = __file_peek(&buf, stream);
+        if (len > 0) {
+            /* Copy straight from the stream buffer */
+            const char *end = memchr(buf, delim, len);
+            if (end)
+                len = end - buf + 1;
+            if ((size_t) (count + len) >= n) {
+                size_t newsize = (count + len + INCR) & ~(size_t) (INCR - 1);
+                char *newline = realloc(line, newsize);
+                if (newline == NULL) {
+                    count = -1;
+                    break;
+                }
+                line = newline;
+                n = newsize;
+            }
+            memcpy(line + count, buf, len);
+            __file_consume(len, stream);
+            count += len;
+            if (end) {
+                line[count] = '\0';
+                break;
+            }
+            continue;
+        }
+
+        int c = len < 0 ? EOF : getc_unlocked(stream);
         if (c == EOF)
             break;
 
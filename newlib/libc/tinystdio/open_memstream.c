@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+#include <malloc.h>
+
+/*
+ * A write-only stream into a growing buffer. Spans are copied
+ * straight into the buffer, which doubles in size as needed. After
+ * each write, *bufp and *sizep point at the data written so far.
+ *
+ * With an arena, the stream and buffer are allocated from that
+ * instead and released with it. The buffer is the latest arena
+ * allocation unless the caller allocates while writing, so it
+ * usually grows in place and only by as much as needed.
+ */
+struct __file_memstream {
+    struct __file_ext xfile;
+    struct malloc_arena *arena;
+    char **bufp;
+    size_t *sizep;
+    char *buf;
+    size_t alloc;   /* Allocated size of buf */
+    size_t size;    /* Length of data */
+    size_t pos;
+};
+
+#define MEMSTREAM_MIN   64
+
+static void
+__memstream_update(struct __file_memstream *ms)
+{
+    *ms->bufp = ms->buf;
+    *ms->sizep = ms->pos < ms->size ? ms->pos : ms->size;
+}
+
+static ssize_t
+__memstream_write(const char *buf, size_t len, FILE *f)
+{
+    struct __file_memstream *ms = (struct __file_memstream *)f;
+    size_t end = ms->pos + len;
+
+    /* Leave room for a NUL after the data */
+    if (end < ms->pos || end + 1 == 0)
+        return _FDEV_ERR;
+    if (end + 1 > ms->alloc) {
+        size_t alloc = ms->alloc;
+        char *new;
+
+        if (ms->arena) {
+            alloc = end + 1;
+            new = malloc_arena_realloc(ms->arena, ms->buf, ms->alloc, alloc);
+        } else {
+            while (alloc < end + 1) {
+                if (alloc > SIZE_MAX / 2) {
+                    alloc = end + 1;
+                    break;
+                }
+                alloc *= 2;
+            }
+            new = realloc(ms->buf, alloc);
+        }
+        if (!new)
+            return _FDEV_ERR;
+        ms->buf = new;
+        ms->alloc = alloc;
+    }
+
+    /* Fill any gap left by seeking past the end with zeros */
+    if (ms->pos > ms->size)
+        memset(ms->buf + ms->size, '\0', ms->pos - ms->size);
+    memcpy(ms->buf + ms->pos, buf, len);
+    ms->pos = end;
+    if (end >= ms->size) {
+        ms->size = end;
+        ms->buf[end] = '\0';
+    }
+    __memstream_update(ms);
+    return len;
+}
+
+static int
+__memstream_put(char c, FILE *f)
+{
+    if (__memstream_write(&c, 1, f) != 1)
+        return _FDEV_ERR;
+    return (unsigned char)c;
+}
+
+static int
+__memstream_flush(FILE *f)
+{
+    __memstream_update((struct __file_memstream *)f);
+    return 0;
+}
+
+static off_t
+__memstream_seek(FILE *f, off_t pos, int whence)
+{
+    struct __file_memstream *ms = (struct __file_memstream *)f;
+
+    switch (whence) {
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        pos += ms->pos;
+        break;
+    case SEEK_END:
+        pos += ms->size;
+        break;
+    default:
+        errno = EINVAL;
+        return EOF;
+    }
+    _Static_assert(sizeof(off_t) >= sizeof(size_t), "must avoid truncation");
+    if (pos < 0 || (unsigned long long) pos > SIZE_MAX) {
+        errno = EINVAL;
+        return EOF;
+    }
+    ms->pos = pos;
+    __memstream_update(ms);
+    return pos;
+}
+
+static int
+__memstream_close(FILE *f)
+{
+    struct __file_memstream *ms = (struct __file_memstream *)f;
+
+    __memstream_update(ms);
+    if (!ms->arena)
+        free(ms);
+    return 0;
+}
+
+FILE *
+malloc_arena_open_memstream(struct malloc_arena *arena, char **bufp, size_t *sizep)
+{
+    struct __file_memstream *ms;
+    char *buf;
+
+    if (!bufp || !sizep) {
+        errno = EINVAL;
+        return NULL;
+    }
+
+    if (arena) {
+        ms = malloc_arena_alloc(arena, sizeof(struct __file_memstream));
+        if (!ms)
+            return NULL;
+        buf = malloc_arena_alloc(arena, MEMSTREAM_MIN);
+        if (!buf)
+            return NULL;
+    } else {
+        ms = malloc(sizeof(struct __file_memstream));
+        if (!ms)
+            return NULL;
+        buf = malloc(MEMSTREAM_MIN);
+        if (!buf) {
+            free(ms);
+            return NULL;
+        }
+    }
+    buf[0] = '\0';
+
+    *ms = (struct __file_memstream){
+        .xfile = __FDEV_SETUP_EXT(__memstream_put, __memstream_write, NULL, NULL,
+                                  __memstream_flush, __memstream_close,
+                                  __memstream_seek, NULL, __SWR),
+        .arena = arena,
+        .bufp = bufp,
+        .sizep = sizep,
+        .buf = buf,
+        .alloc = MEMSTREAM_MIN,
+        .size = 0,
+        .pos = 0,
+    };
+    __memstream_update(ms);
+
+    return (FILE *)ms;
+}
+
+FILE *
+open_memstream(char **bufp, size_t *sizep)
+{
+    return malloc_arena_open_memstream(NULL, bufp, sizep);
+}
@@ -50,5 +50,9 @@ __weak_reference(__posix_stdout,stdout);
 __attribute__((destructor (101)))
 static void posix_exit(void)
 {
+#ifdef __BUFIO_BATCH_FLUSH
+    fflush(NULL);
+#else
     fflush(stdout);
+#endif
 }
@@ -34,8 +34,7 @@
 int
 puts(const char *str)
 {
-        int (*put)(char, struct __file *);
-	char c;
+        size_t len;
 	int ret = EOF;
         FILE *out = stdout;
 
@@ -44,12 +43,11 @@ puts(const char *str)
 	if ((out->flags & __SWR) == 0)
 		goto exit;
 
-        put = out->put;
-	while ((c = *str++) != '\0')
-		if (put(c, out) < 0)
-			goto flag_exit;
+        len = strlen(str);
+        if (__file_write(str, len, out) != len)
+		goto flag_exit;
 
-	if (put('\n', out) < 0)
+	if (out->put('\n', out) < 0)
 		goto flag_exit;
 
 	ret = 0;
@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/lock.h>
+#include <sys/uio.h>
 
 #define __BALL  0x0001          /* bufio buf is allocated by stdio */
 #define __BLBF  0x0002          /* bufio is line buffered */
@@ -59,6 +60,10 @@ struct __file_bufio {
         const void *ptr;
         uint8_t dir;
         uint8_t bflags;
+#ifdef __BUFIO_BATCH_FLUSH
+        uint8_t listed; /* on the list of streams flushed by fflush(NULL) */
+        struct __file_bufio *next;
+#endif
         __off_t pos;    /* FD position */
 	char	*buf;
         int     size;   /* sizeof buf */
@@ -72,6 +77,10 @@ struct __file_bufio {
                 ssize_t (*write_int)(int fd, const void *buf, size_t count);
                 ssize_t (*write_ptr)(void *ptr, const void *buf, size_t count);
         };
+        union {
+                ssize_t (*writev_int)(int fd, const struct iovec *iov, int iovcnt);
+                ssize_t (*writev_ptr)(void *ptr, const struct iovec *iov, int iovcnt);
+        };
         union {
                 __off_t (*lseek_int)(int fd, __off_t offset, int whence);
                 __off_t (*lseek_ptr)(void *ptr, __off_t offset, int whence);
@@ -85,12 +94,17 @@ struct __file_bufio {
 #endif
 };
 
-#define FDEV_SETUP_BUFIO(_fd, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
+/*
+ * A writev function, if provided, is used to send buffered data
+ * together with a large write in a single call.
+ */
+#define FDEV_SETUP_BUFIO_WRITEV(_fd, _buf, _size, _read, _write, _writev, _lseek, _close, _rwflag, _bflags) \
         {                                                               \
-                .xfile = FDEV_SETUP_EXT(__bufio_put, __bufio_get,     \
-                                        __bufio_flush, __bufio_close,   \
-                                        __bufio_seek, __bufio_setvbuf,  \
-                                        (_rwflag) | __SBUF),            \
+                .xfile = __FDEV_SETUP_EXT(__bufio_put, __bufio_write, \
+                                          __bufio_get, __bufio_peek,    \
+                                          __bufio_flush, __bufio_close, \
+                                          __bufio_seek, __bufio_setvbuf, \
+                                          (_rwflag) | __SBUF),          \
                 .ptr = (void *) (intptr_t) (_fd),                       \
                 .dir = 0,                                               \
                 .bflags = (_bflags),                                    \
@@ -101,16 +115,21 @@ struct __file_bufio {
                 .off = 0,                                               \
                 { .read_int = _read },                                  \
                 { .write_int = _write },                                \
+                { .writev_int = _writev },                              \
                 { .lseek_int = _lseek },                                \
                 { .close_int = _close }                                 \
         }
 
+#define FDEV_SETUP_BUFIO(_fd, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
+        FDEV_SETUP_BUFIO_WRITEV(_fd, _buf, _size, _read, _write, NULL, _lseek, _close, _rwflag, _bflags)
+
 #define FDEV_SETUP_BUFIO_PTR(_ptr, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
         {                                                               \
-                .xfile = FDEV_SETUP_EXT(__bufio_put, __bufio_get,     \
-                                        __bufio_flush, __bufio_close,   \
-                                        __bufio_seek, __bufio_setvbuf,  \
-                                        (_rwflag) | __SBUF),            \
+                .xfile = __FDEV_SETUP_EXT(__bufio_put, __bufio_write, \
+                                          __bufio_get, __bufio_peek,    \
+                                          __bufio_flush, __bufio_close, \
+                                          __bufio_seek, __bufio_setvbuf, \
+                                          (_rwflag) | __SBUF),          \
                 .ptr = _ptr,                                            \
                 .dir = 0,                                               \
                 .bflags = (_bflags) | __BFPTR,                          \
@@ -121,6 +140,7 @@ struct __file_bufio {
                 .off = 0,                                               \
                 { .read_ptr = _read },                                  \
                 { .write_ptr = _write },                                \
+                { .writev_ptr = NULL },                                 \
                 { .lseek_ptr = _lseek },                                \
                 { .close_ptr = _close }                                 \
         }
@@ -174,9 +194,18 @@ __bufio_flush(FILE *f);
 int
 __bufio_put(char c, FILE *f);
 
+ssize_t
+__bufio_write(const char *buf, size_t len, FILE *f);
+
+int
+__bufio_flush_all(void);
+
 int
 __bufio_get(FILE *f);
 
+ssize_t
+__bufio_peek(const char **buf, size_t consume, FILE *f);
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence);
 
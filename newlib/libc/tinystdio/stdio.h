@@ -100,6 +100,8 @@ struct __file {
 	int	(*put)(char, struct __file *);	/* function to write one char to device */
 	int	(*get)(struct __file *);	/* function to read one char from device */
 	int	(*flush)(struct __file *);	/* function to flush output to device */
+	__ssize_t (*write)(const char *, size_t, struct __file *); /* optional function to write a span of chars */
+	__ssize_t (*peek)(const char **, size_t, struct __file *); /* optional function to expose buffered input */
 #ifdef __STDIO_LOCKING
 	_LOCK_RECURSIVE_T lock;
 #endif
@@ -120,25 +122,31 @@ struct __file_close {
 	int	(*close)(struct __file *);	/* function to close file */
 };
 
-#define FDEV_SETUP_CLOSE(__put, __get, __flush, __close, __flags) \
+#define __FDEV_SETUP_CLOSE(__put, __write, __get, __peek, __flush, __close, __flags) \
         {                                                               \
-                .file = FDEV_SETUP_STREAM(__put, __get, __flush, (__flags) | __SCLOSE),   \
+                .file = __FDEV_SETUP_STREAM(__put, __write, __get, __peek, __flush, (__flags) | __SCLOSE), \
                 .close = (__close),                                      \
         }
 
+#define FDEV_SETUP_CLOSE(__put, __get, __flush, __close, __flags) \
+        __FDEV_SETUP_CLOSE(__put, NULL, __get, NULL, __flush, __close, __flags)
+
 struct __file_ext {
         struct __file_close cfile;              /* close file struct */
         __off_t (*seek)(struct __file *, __off_t offset, int whence);
         int     (*setvbuf)(struct __file *, char *buf, int mode, size_t size);
 };
 
-#define FDEV_SETUP_EXT(__put, __get, __flush, __close, __seek, __setvbuf, __flags) \
+#define __FDEV_SETUP_EXT(__put, __write, __get, __peek, __flush, __close, __seek, __setvbuf, __flags) \
         {                                                               \
-                .cfile = FDEV_SETUP_CLOSE(__put, __get, __flush, __close, (__flags) | __SEXT), \
+                .cfile = __FDEV_SETUP_CLOSE(__put, __write, __get, __peek, __flush, __close, (__flags) | __SEXT), \
                 .seek = (__seek),                                        \
                 .setvbuf = (__setvbuf),                                  \
         }
 
+#define FDEV_SETUP_EXT(__put, __get, __flush, __close, __seek, __setvbuf, __flags) \
+        __FDEV_SETUP_EXT(__put, NULL, __get, NULL, __flush, __close, __seek, __setvbuf, __flags)
+
 /*@{*/
 /**
    \c FILE is the opaque structure that is passed around between the
@@ -195,14 +203,19 @@ extern FILE *const stderr;
  */
 #define _FDEV_EOF (-2)
 
-#define FDEV_SETUP_STREAM(__put, __get, __flush, __flags)        \
+#define __FDEV_SETUP_STREAM(__put, __write, __get, __peek, __flush, __flags) \
 	{                                           \
                 .flags = (__flags),                 \
                 .put = (__put),                     \
                 .get = (__get),                     \
                 .flush = (__flush),                 \
+                .write = (__write),                 \
+                .peek = (__peek),                   \
 	}
 
+#define FDEV_SETUP_STREAM(__put, __get, __flush, __flags)        \
+        __FDEV_SETUP_STREAM(__put, NULL, __get, NULL, __flush, __flags)
+
 FILE *fdevopen(int (*__put)(char, FILE*), int (*__get)(FILE*), int(*__flush)(FILE *));
 int	fclose(FILE *__stream);
 int	fflush(FILE *stream);
@@ -281,6 +294,9 @@ int     asprintf(char **strp, const char *fmt, ...) __PRINTF_ATTRIBUTE__(2,3);
 char    *asnprintf(char *str, size_t *lenp, const char *fmt, ...) __PRINTF_ATTRIBUTE__(3,4);
 int     vasprintf(char **strp, const char *fmt, __gnuc_va_list ap) __PRINTF_ATTRIBUTE__(2,0);
 char    *vasnprintf(char *str, size_t *lenp, const char *fmt, __gnuc_va_list ap) __PRINTF_ATTRIBUTE__(3,0);
+struct malloc_arena;
+int     malloc_arena_asprintf(struct malloc_arena *arena, char **strp, const char *fmt, ...) __PRINTF_ATTRIBUTE__(3,4);
+int     malloc_arena_vasprintf(struct malloc_arena *arena, char **strp, const char *fmt, __gnuc_va_list ap) __PRINTF_ATTRIBUTE__(3,0);
 
 int	fputs(const char *__str, FILE *__stream);
 int	puts(const char *__str);
@@ -403,6 +419,8 @@ FILE *fopen(const char *path, const char *mode) __malloc_like_with_free(fclose,
 FILE *freopen(const char *path, const char *mode, FILE *stream);
 FILE *fdopen(int, const char *) __malloc_like_with_free(fclose, 1);
 FILE *fmemopen(void *buf, size_t size, const char *mode) __malloc_like_with_free(fclose, 1);
+FILE *open_memstream(char **bufp, size_t *sizep) __malloc_like_with_free(fclose, 1);
+FILE *malloc_arena_open_memstream(struct malloc_arena *arena, char **bufp, size_t *sizep);
 int fseek(FILE *stream, long offset, int whence);
 int fseeko(FILE *stream, __off_t offset, int whence);
 int fsetpos(FILE *stream, const fpos_t *pos);
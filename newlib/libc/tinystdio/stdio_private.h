@@ -60,6 +60,9 @@ struct __file_str {
 int
 __file_str_get(FILE *stream);
 
+ssize_t
+__file_str_peek(const char **buf, size_t consume, FILE *stream);
+
 int
 __file_wstr_get(FILE *stream);
 
@@ -69,6 +72,25 @@ __file_str_put(char c, FILE *stream);
 int
 __file_str_put_alloc(char c, FILE *stream);
 
+ssize_t
+__file_str_write(const char *buf, size_t len, FILE *stream);
+
+ssize_t
+__file_str_write_alloc(const char *buf, size_t len, FILE *stream);
+
+struct malloc_arena;
+
+struct __file_str_arena {
+        struct __file_str str;
+        struct malloc_arena *arena;     /* storage source */
+};
+
+int
+__file_str_put_arena(char c, FILE *stream);
+
+ssize_t
+__file_str_write_arena(const char *buf, size_t len, FILE *stream);
+
 extern const char __match_inf[];
 extern const char __match_inity[];
 extern const char __match_nan[];
@@ -90,6 +112,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SRD,		\
                         .get = __file_str_get,  \
+                        .peek = __file_str_peek, \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = (char *) (_s)		\
@@ -112,6 +135,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put,	\
+			.write = __file_str_write, \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = (_s),			\
@@ -122,6 +146,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put_alloc,	\
+			.write = __file_str_write_alloc, \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = NULL,			\
@@ -134,6 +159,7 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 		.file = {			\
 			.flags = __SWR,		\
 			.put = __file_str_put_alloc,	\
+			.write = __file_str_write_alloc, \
                         __LOCK_INIT_NONE        \
 		},				\
 		.pos = _buf,			\
@@ -142,6 +168,22 @@ bool __matchcaseprefix(const char *input, const char *pattern);
                 .alloc = false,                 \
 	}
 
+#define FDEV_SETUP_STRING_ARENA(_arena) {  \
+                .str = {                        \
+                        .file = {               \
+                                .flags = __SWR, \
+                                .put = __file_str_put_arena, \
+                                .write = __file_str_write_arena, \
+                                __LOCK_INIT_NONE \
+                        },                      \
+                        .pos = NULL,            \
+                        .end = NULL,            \
+                        .size = 0,              \
+                        .alloc = true,          \
+                },                              \
+                .arena = (_arena),              \
+	}
+
 #define _FDEV_BUFIO_FD(bf) ((int)((intptr_t) (bf)->ptr))
 
 #define IO_VARIANT_IS_FLOAT(v)        ((v) == __IO_VARIANT_FLOAT || (v) == __IO_VARIANT_DOUBLE)
@@ -182,6 +224,24 @@ static inline ssize_t bufio_write(struct __file_bufio *bf, const void *buf, size
     return (bf->write_ptr)((void *) bf->ptr, buf, count);
 }
 
+static inline bool bufio_has_writev(struct __file_bufio *bf)
+{
+#ifndef BUFIO_ABI_MATCHES
+    if (!(bf->bflags & __BFPTR))
+        return bf->writev_int != NULL;
+#endif
+    return bf->writev_ptr != NULL;
+}
+
+static inline ssize_t bufio_writev(struct __file_bufio *bf, const struct iovec *iov, int iovcnt)
+{
+#ifndef BUFIO_ABI_MATCHES
+    if (!(bf->bflags & __BFPTR))
+        return (bf->writev_int)(_FDEV_BUFIO_FD(bf), iov, iovcnt);
+#endif
+    return (bf->writev_ptr)((void *) bf->ptr, iov, iovcnt);
+}
+
 static inline __off_t bufio_lseek(struct __file_bufio *bf, __off_t offset, int whence)
 {
 #ifndef BUFIO_ABI_MATCHES
@@ -213,10 +273,13 @@ static inline int bufio_close(struct __file_bufio *bf)
     return ret;
 }
 
+/* Not all systems provide writev; bufio works without it */
+extern ssize_t writev(int, const struct iovec *, int) __weak;
+
 #define FDEV_SETUP_POSIX(fd, buf, size, rwflags, bflags)      \
-        FDEV_SETUP_BUFIO(fd, buf, size,                       \
-                         read, write,                         \
-                         lseek, close, rwflags, bflags)
+        FDEV_SETUP_BUFIO_WRITEV(fd, buf, size,                \
+                                read, write, writev,          \
+                                lseek, close, rwflags, bflags)
 
 int
 __stdio_flags (const char *mode, int *optr);
@@ -231,6 +294,26 @@ void __flockfile_init(FILE *f);
 
 #define __funlock_return(f, v) do { __funlockfile(f); return (v); } while(0)
 
+/*
+ * Write a span of chars, using the write function when the stream
+ * provides one and falling back to put otherwise. Returns the number
+ * of chars written; anything short of 'len' indicates an error.
+ */
+static inline size_t
+__file_write(const char *buf, size_t len, FILE *stream)
+{
+        size_t n;
+
+        if (stream->write) {
+                ssize_t ret = stream->write(buf, len, stream);
+                return ret < 0 ? 0 : (size_t) ret;
+        }
+        for (n = 0; n < len; n++)
+                if (stream->put(buf[n], stream) < 0)
+                        break;
+        return n;
+}
+
 static inline void __flockfile(FILE *f) {
 	(void) f;
 #ifdef __STDIO_LOCKING
@@ -787,6 +870,36 @@ __picolibc_non_atomic_compare_exchange_ungetc(__ungetc_t *p,
 
 #endif /* __ATOMIC_UNGETC */
 
+/*
+ * Return the buffered input available from a stream. Returns 0 when
+ * the stream has no peek function or has a pending ungetc, in which
+ * case the caller should use getc instead. At end of file or on
+ * error, sets the stream flags and returns EOF.
+ */
+static inline ssize_t
+__file_peek(const char **buf, FILE *stream)
+{
+        ssize_t len;
+
+        if (!stream->peek || (stream->flags & __SRD) == 0 ||
+            __atomic_load_ungetc(&stream->unget) != 0)
+                return 0;
+        len = stream->peek(buf, 0, stream);
+        if (len < 0) {
+                stream->flags |= (len == _FDEV_ERR) ? __SERR : __SEOF;
+                return EOF;
+        }
+        return len;
+}
+
+/* Discard chars returned by __file_peek */
+static inline void
+__file_consume(size_t len, FILE *stream)
+{
+        if (len)
+                (void) stream->peek(NULL, len, stream);
+}
+
 /*
  * This operates like _tolower on upper case letters, but also works
  * correctly on lower case letters.
@@ -497,6 +497,31 @@ _wcslen(const char *s, size_t maxlen)
 }
 #endif
 
+/*
+ * Narrow printf variants (other than the minimal one) hand runs of
+ * chars to the stream write function instead of calling put for
+ * each one
+ */
+#if !defined(WIDE_CHARS) && !defined(_NEED_IO_SHRINK)
+#define PRINTF_SPANS
+
+static bool
+_write_pad(char c, int n, FILE *stream)
+{
+    char pad[16];
+    size_t len = n < (int) sizeof(pad) ? (size_t) n : sizeof(pad);
+
+    memset(pad, c, len);
+    while (n > 0) {
+        size_t this = (size_t) n < len ? (size_t) n : len;
+        if (__file_write(pad, this, stream) != this)
+            return false;
+        n -= this;
+    }
+    return true;
+}
+#endif
+
 #ifdef VFPRINTF_S
 int
 vfprintf_s(FILE *__restrict stream, const char *__restrict fmt, va_list ap_orig)
@@ -560,6 +585,31 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
 #endif
 
+#ifdef PRINTF_SPANS
+#define my_puts(s, len, stream) do {                                    \
+        size_t _len = (len);                                            \
+        stream_len += _len;                                             \
+        if (__file_write(s, _len, stream) != _len) goto fail;           \
+    } while(0)
+#define my_pad(c, n, stream) do {                                       \
+        int _n = (n);                                                   \
+        if (_n > 0) {                                                   \
+            stream_len += _n;                                           \
+            if (!_write_pad(c, _n, stream)) goto fail;                  \
+        }                                                               \
+    } while(0)
+#else
+#define my_puts(s, len, stream) do {                                    \
+        const char *_s = (s);                                           \
+        size_t _len = (len);                                            \
+        while (_len--) my_putc(*_s++, stream);                          \
+    } while(0)
+#define my_pad(c, n, stream) do {                                       \
+        int _n = (n);                                                   \
+        while (_n-- > 0) my_putc(c, stream);                            \
+    } while(0)
+#endif
+
     __flockfile(stream);
 
     if ((stream->flags & __SWR) == 0)
@@ -572,12 +622,23 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
     for (;;) {
 
 	for (;;) {
+#ifdef PRINTF_SPANS
+            const char *lit = fmt;
+            while ((c = (unsigned char) *fmt) != '\0' && c != '%')
+                fmt++;
+            my_puts(lit, fmt - lit, stream);
+            if (!c) goto ret;
+            fmt++;
+            c = *fmt++;
+            if (c != '%') break;
+#else
 	    c = *fmt++;
 	    if (!c) goto ret;
 	    if (c == '%') {
 		c = *fmt++;
 		if (c != '%') break;
 	    }
+#endif
 	    my_putc (c, stream);
 	}
 
@@ -870,9 +931,8 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 		if (width > ndigs) {
 		    width -= ndigs;
 		    if (!(flags & FL_LPAD)) {
-			do {
-			    my_putc (' ', stream);
-			} while (--width);
+			my_pad (' ', width, stream);
+			width = 0;
 		    }
 		} else {
 		    width = 0;
@@ -976,10 +1036,8 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 
                 /* Output before first digit	*/
                 if (!(flags & (FL_LPAD | FL_ZFILL))) {
-                    while (width) {
-                        my_putc (' ', stream);
-                        width--;
-                    }
+                    my_pad (' ', width, stream);
+                    width = 0;
                 }
                 if (sign)
                     my_putc (sign, stream);
@@ -992,10 +1050,8 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
 
                 if (!(flags & FL_LPAD)) {
-                    while (width) {
-                        my_putc ('0', stream);
-                        width--;
-                    }
+                    my_pad ('0', width, stream);
+                    width = 0;
                 }
 
                 if (flags & FL_FLTFIX) {		/* 'f' format		*/
@@ -1037,9 +1093,13 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                     my_putc (dtoa.digits[0], stream);
                     if (prec > 0) {
                         my_putc ('.', stream);
-                        int pos = 1;
-                        for (pos = 1; pos < 1 + prec; pos++)
-                            my_putc (pos < ndigs ? dtoa.digits[pos] : '0', stream);
+                        int ndigs_frac = ndigs - 1;
+                        if (ndigs_frac > prec)
+                            ndigs_frac = prec;
+                        if (ndigs_frac < 0)
+                            ndigs_frac = 0;
+                        my_puts (dtoa.digits + 1, ndigs_frac, stream);
+                        my_pad ('0', prec - ndigs_frac, stream);
                     } else if (flags & FL_ALT)
                         my_putc ('.', stream);
 
@@ -1144,9 +1204,9 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
             str_lpad:
                 if (!(flags & FL_LPAD)) {
-                    while ((size_t) width > size) {
-                        my_putc (' ', stream);
-                        width--;
+                    if ((size_t) width > size) {
+                        my_pad (' ', width - (int) size, stream);
+                        width = size;
                     }
                 }
                 width -= size;
@@ -1180,8 +1240,7 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                         pnt += mb_len;
                     }
 #else
-                    while (size--)
-                        my_putc (*pnt++, stream);
+                    my_puts (pnt, size, stream);
 #endif
                 }
 #endif
@@ -1313,9 +1372,9 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                             len = width;
                         }
                     }
-                    while (len < width) {
-                        my_putc (' ', stream);
-                        len++;
+                    if (len < width) {
+                        my_pad (' ', width - len, stream);
+                        len = width;
                     }
                 }
 
@@ -1335,10 +1394,7 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
                 }
 
                 /* Output leading zeros */
-                while (prec > buf_len) {
-                    my_putc ('0', stream);
-                    prec--;
-                }
+                my_pad ('0', prec - buf_len, stream);
 #else
                 if (flags & FL_ALT) {
                     my_putc ('0', stream);
@@ -1349,16 +1405,24 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
 
                 /* Output value */
+#ifdef PRINTF_SPANS
+                /* __ultoa_invert generates digits in reverse order */
+                for (int lo = 0, hi = buf_len - 1; lo < hi; lo++, hi--) {
+                    char t = buf[lo];
+                    buf[lo] = buf[hi];
+                    buf[hi] = t;
+                }
+                my_puts (buf, buf_len, stream);
+#else
                 while (buf_len)
                     my_putc (buf[--buf_len], stream);
+#endif
             }
         }
 
 #ifndef _NEED_IO_SHRINK
 	/* Tail is possible.	*/
-	while (width-- > 0) {
-	    my_putc (' ', stream);
-	}
+	my_pad (' ', width, stream);
 #endif
     } /* for (;;) */
 
@@ -1368,6 +1432,8 @@ int vfprintf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #endif
     __funlock_return(stream, stream_len);
 #undef my_putc
+#undef my_puts
+#undef my_pad
 #undef ap
   fail:
     stream->flags |= __SERR;
@@ -120,12 +120,38 @@ typedef struct {
 } scanf_context_t;
 #define SCANF_CONTEXT_INIT { .len = 0, .unget = MY_EOF }
 #define scanf_len(context) ((context)->len)
+#elif !defined(_NEED_IO_SHRINK)
+/*
+ * Narrow scanf variants (other than the minimal one) read directly
+ * from the stream buffer when the stream can expose it, only calling
+ * getc when that is empty
+ */
+#define SCANF_SPANS
+typedef struct {
+    int         len;
+    const char  *start;         /* beginning of stream buffer window */
+    const char  *pos;           /* next char to read */
+    const char  *end;           /* end of window */
+} scanf_context_t;
+#define SCANF_CONTEXT_INIT { .len = 0, .start = NULL, .pos = NULL, .end = NULL }
+#define scanf_len(context) ((context)->len)
 #else
 typedef int scanf_context_t;
 #define SCANF_CONTEXT_INIT 0
 #define scanf_len(context) (*(context))
 #endif
 
+#ifdef SCANF_SPANS
+/* Tell the stream how many chars were used from the window */
+static void
+scanf_sync(FILE *stream, scanf_context_t *context)
+{
+    if (context->pos != context->start)
+        __file_consume(context->pos - context->start, stream);
+    context->start = context->pos = context->end = NULL;
+}
+#endif
+
 static INT
 scanf_getc(FILE *stream, scanf_context_t *context)
 {
@@ -134,6 +160,24 @@ scanf_getc(FILE *stream, scanf_context_t *context)
     c = context->unget;
     context->unget = MY_EOF;
     if (IS_EOF(c))
+#endif
+#ifdef SCANF_SPANS
+    if (context->pos == context->end) {
+        const char *buf;
+        ssize_t len;
+
+        scanf_sync(stream, context);
+        len = __file_peek(&buf, stream);
+        if (len < 0)
+            return MY_EOF;
+        if (len > 0) {
+            context->start = context->pos = buf;
+            context->end = buf + len;
+        }
+    }
+    if (context->pos != context->end)
+        c = (unsigned char) *context->pos++;
+    else
 #endif
         c = GETC(stream);
     if (!IS_EOF(c))
@@ -150,6 +194,13 @@ scanf_ungetc(INT c, FILE *stream, scanf_context_t *context)
     (void) stream;
     context->unget = c;
 #else
+#ifdef SCANF_SPANS
+    /* The char must have come from the window, just back up */
+    if (!IS_EOF(c) && context->pos != context->start) {
+        context->pos--;
+        return;
+    }
+#endif
     UNGETC(c, stream);
 #endif
 }
@@ -859,6 +910,9 @@ int vfscanf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #ifdef WIDE_CHARS
     if (!IS_EOF(context.unget))
         UNGETC(context.unget, stream);
+#endif
+#ifdef SCANF_SPANS
+    scanf_sync(stream, &context);
 #endif
     __funlock_return(stream, nconvs);
 
@@ -869,6 +923,9 @@ int vfscanf (FILE * stream, const CHAR *fmt, va_list ap_orig)
 #ifdef WIDE_CHARS
     if (!IS_EOF(context.unget))
         UNGETC(context.unget, stream);
+#endif
+#ifdef SCANF_SPANS
+    scanf_sync(stream, &context);
 #endif
     __funlock_return(stream, nconvs ? nconvs : EOF);
 }
@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+#include "atan.h"
+
+/* Table-driven atan.  Arguments from 2^-4 to 2^4 go through the table,
+   smaller ones use the polynomial directly and larger ones use
+   atan (x) = PI/2 - atan (1/x).  Worst-case error is about 0.52 ULP.  */
+double
+atan (double x)
+{
+  double_t a, z, hi, lo;
+  uint32_t abstop = abstop12 (x);
+
+  if (unlikely (abstop - abstop12 (0x1p-27)
+		>= abstop12 (0x1p60) - abstop12 (0x1p-27)))
+    {
+      if (abstop < abstop12 (0x1p-27))
+	{
+	  if (unlikely (abstop < abstop12 (0x1p-1022)))
+	    /* Force underflow for tiny x.  */
+	    force_eval_double (x * x);
+	  return x;
+	}
+      if (isnan (x))
+	return x + x;
+      /* atan (x) rounds to +-PI/2.  */
+      hi = eval_as_double (Pio2hi + Pio2lo);
+      return asuint64 (x) >> 63 ? -hi : hi;
+    }
+
+  a = fabs (x);
+  if (abstop < abstop12 (0x1p-4))
+    hi = eval_as_double (a + atan_poly1 (a));
+  else if (abstop >= abstop12 (0x1p4))
+    {
+      /* 1/a is below 2^-4, so its rounding error hardly shows next to
+	 PI/2.  */
+      z = 1.0 / a;
+      hi = Pio2hi - z;
+      lo = ((Pio2hi - hi) - z) + (Pio2lo - atan_poly1 (z));
+      hi = eval_as_double (hi + lo);
+    }
+  else
+    {
+      hi = atan_inline (a, 1.0, a, &lo);
+      hi = eval_as_double (hi + lo);
+    }
+  return asuint64 (x) >> 63 ? -hi : hi;
+}
+
+_MATH_ALIAS_d_d(atan)
+
+#endif /* __OBSOLETE_MATH_DOUBLE */
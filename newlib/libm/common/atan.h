@@ -0,0 +1,189 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Shared pieces of the inverse tangent functions.
+
+   atan (P/Q) for P/Q in [2^-4, 2^4) is computed as
+
+	atan (P/Q) = atan (C) + atan (T),  T = (P - C * Q) / (Q + C * P)
+
+   where C is the middle of one of 2^ATAN_TABLE_BITS equal steps in the
+   binade holding P/Q, so |T| < 2^-7 and three terms of the Taylor series
+   give atan (T).  C has only a few significant bits, making P - C * Q
+   exact, and T is left as a plain double: it is below 2^-5 of the
+   result, so its rounding errors add only a few hundredths of an ULP.
+   atan (C) comes from the table as a pair of doubles.  Outside that range a longer polynomial
+   is used on P/Q or Q/P directly.  */
+
+#ifndef _ATAN_H_
+#define _ATAN_H_
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+#define ATAN_TABLE_BITS 5
+/* The table covers the eight binades from 2^-4 to 2^4.  */
+#define ATAN_N (8 << ATAN_TABLE_BITS)
+#define ATAN_SHIFT (52 - ATAN_TABLE_BITS)
+#define ATAN_OFF (0x3fb0000000000000ULL >> ATAN_SHIFT)
+
+extern const struct atan_data
+{
+  double pio2hi, pio2lo;	/* PI/2 as the sum of two doubles.  */
+  double poly[3];		/* atan (t) - t = t^3 * A (t^2), |t| < 2^-7.  */
+  double poly1[5];		/* atan (z) - z = z^3 * B (z^2), |z| < 2^-4.  */
+  /* atan (C) for each table point, as pairs of doubles.  */
+  double tab[2 * ATAN_N];
+} __atan_data HIDDEN;
+
+#define Pio2hi __atan_data.pio2hi
+#define Pio2lo __atan_data.pio2lo
+#define A __atan_data.poly
+#define B __atan_data.poly1
+#define T __atan_data.tab
+
+/* Top 12 bits of the double representation with the sign bit cleared.  */
+static inline uint32_t
+abstop12 (double x)
+{
+  return (asuint64 (x) >> 52) & 0x7ff;
+}
+
+/* Return X * Y and store the rounding error of the product in *E.  */
+static inline double_t
+atan_mul (double_t x, double_t y, double_t *e)
+{
+  double_t p = x * y;
+#if __HAVE_FAST_FMA
+  *e = fma (x, y, -p);
+#else
+  /* Split x and y so that the partial products are exact.  */
+  double_t xhi = asfloat64 (asuint64 (x) & -1ULL << 27);
+  double_t xlo = x - xhi;
+  double_t yhi = asfloat64 (asuint64 (y) & -1ULL << 27);
+  double_t ylo = y - yhi;
+  *e = ((xhi * yhi - p) + xhi * ylo + xlo * yhi) + xlo * ylo;
+#endif
+  return p;
+}
+
+/* Return atan (Z) - Z for |Z| < 2^-4.  */
+static inline double_t
+atan_poly1 (double_t z)
+{
+  double_t z2 = z * z;
+  double_t z4 = z2 * z2;
+  return z * z2 * ((B[0] + z2 * B[1]) + z4 * (B[2] + z2 * B[3] + z4 * B[4]));
+}
+
+/* Compute atan (P/Q) for P, Q > 0, returning the result as the sum of
+   the return value and *LO.  R is P/Q, which need only be accurate
+   enough to pick the table entry and must be in [2^-4, 2^4).  P and Q
+   must be within about 2^500 of 1 so that none of the small terms
+   underflow.  */
+static __always_inline double_t
+atan_inline (double_t p, double_t q, double_t r, double_t *lo)
+{
+  uint64_t ir = asuint64 (r);
+  uint32_t i = (ir >> ATAN_SHIFT) - ATAN_OFF;
+  double_t c, qh, num, t, z, y, hi;
+
+  /* The middle of the step holding r, with ATAN_TABLE_BITS + 2
+     significant bits.  */
+  c = asfloat64 ((ir & -1ULL << ATAN_SHIFT) + (1ULL << (ATAN_SHIFT - 1)));
+
+  /* c * qh and c * (q - qh) are exact, and c * qh is within a factor of
+     two of p, so only the last subtraction rounds.  */
+  qh = asfloat64 (asuint64 (q) & -1ULL << 27);
+  num = (p - c * qh) - c * (q - qh);
+  t = num / (q + c * p);
+
+  z = t * t;
+  y = t * z * (A[0] + z * (A[1] + z * A[2]));
+
+  /* |t| < atan (c) / 8, so this is a fast two sum.  */
+  hi = T[2 * i] + t;
+  *lo = ((T[2 * i] - hi) + t) + (T[2 * i + 1] + y);
+  return hi;
+}
+
+/* Return K * PI/2 plus HI + LO, or minus it if NEG is set, for K in
+   0 .. 2.  */
+static inline double
+atan_quadrant (uint32_t k, uint32_t neg, double_t hi, double_t lo)
+{
+  double_t bh = (double_t) (int32_t) k * Pio2hi;
+  double_t bl = (double_t) (int32_t) k * Pio2lo;
+  /* +-1, to flip the signs without a branch.  */
+  double_t f = asfloat64 (0x3ff0000000000000ULL | (uint64_t) neg << 63);
+  double_t s;
+
+  hi *= f;
+  lo *= f;
+  /* |hi| <= PI/4 + tiny, so this is a fast two sum even when bh is 0.  */
+  s = bh + hi;
+  lo += ((bh - s) + hi) + bl;
+  return eval_as_double (s + lo);
+}
+
+/* Compute atan (R) for R >= 0, which may be infinite, for the single
+   precision functions.  The result is accurate to about 2^-40.  */
+static inline double_t
+atanf_inline (double_t r)
+{
+  uint64_t ir = asuint64 (r);
+  double_t c, t, z;
+  uint32_t i;
+
+  if (ir < 0x3fb0000000000000ULL)
+    {
+      z = r * r;
+      return r + r * z * (B[0] + z * (B[1] + z * B[2]));
+    }
+  if (ir >= 0x4030000000000000ULL)
+    {
+      r = 1.0 / r;
+      z = r * r;
+      return Pio2hi - (r + r * z * (B[0] + z * (B[1] + z * B[2])));
+    }
+  i = (ir >> ATAN_SHIFT) - ATAN_OFF;
+  c = asfloat64 ((ir & -1ULL << ATAN_SHIFT) + (1ULL << (ATAN_SHIFT - 1)));
+  t = (r - c) / (1.0 + r * c);
+  z = t * t;
+  return T[2 * i] + (t + t * z * A[0]);
+}
+
+#endif /* _ATAN_H_ */
@@ -0,0 +1,141 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+#include "atan.h"
+
+/* Inputs with top bits outside [ATAN2_LOW, ATAN2_HIGH) go through the
+   special case code.  */
+#define ATAN2_LOW abstop12 (0x1p-500)
+#define ATAN2_HIGH abstop12 (0x1p500)
+
+static inline int
+atan2_special (uint32_t abstop)
+{
+  return abstop - ATAN2_LOW >= ATAN2_HIGH - ATAN2_LOW;
+}
+
+/* Handle NaN, zero and infinite arguments and those so far apart that
+   atan of their ratio is the ratio itself, and scale the others into
+   range.  */
+static __noinline double
+specialcase (double y, double x, uint32_t topx, uint32_t topy)
+{
+  double_t hi;
+  int xneg = asuint64 (x) >> 63;
+
+  if (isnan (x) || isnan (y))
+    return x + y;
+  /* Below a ratio of 2^100 scale both into range, which is exact.  */
+  if (x != 0.0 && y != 0.0 && isfinite (x) && isfinite (y)
+      && topx <= topy + 100 && topy <= topx + 100)
+    {
+      if (topx > 0x3ff || topy > 0x3ff)
+	return atan2 (y * 0x1p-600, x * 0x1p-600);
+      return atan2 (y * 0x1p600, x * 0x1p600);
+    }
+  if (y == 0.0)
+    {
+      /* atan2 (+-0, x) is +-0 for x > 0 or +0, +-PI otherwise.  */
+      if (!xneg)
+	return y;
+      hi = eval_as_double (2.0 * Pio2hi + 2.0 * Pio2lo);
+    }
+  else if (isinf (x))
+    {
+      if (isinf (y))
+	/* +-PI/4 or +-3PI/4.  */
+	hi = eval_as_double ((xneg ? 3.0 : 1.0)
+			     * (0.5 * Pio2hi + 0.5 * Pio2lo));
+      else if (xneg)
+	hi = eval_as_double (2.0 * Pio2hi + 2.0 * Pio2lo);
+      else
+	hi = 0.0;
+    }
+  else if (x == 0.0 || isinf (y) || topy > topx)
+    hi = eval_as_double (Pio2hi + Pio2lo);
+  else if (xneg)
+    hi = eval_as_double (2.0 * Pio2hi + 2.0 * Pio2lo);
+  else
+    return check_uflow (eval_as_double (y / x));
+  return asuint64 (y) >> 63 ? -hi : hi;
+}
+
+/* Table-driven atan2.  The smaller of |y| and |x| is divided by the
+   larger, and only the table index and small ratios depend on the
+   rounded quotient, whose error is otherwise carried along.  The octant
+   is applied without branches.  Worst-case error is about 0.52 ULP.  */
+double
+atan2 (double y, double x)
+{
+  double_t p, q, inv, r, e, hi, lo;
+  uint64_t ix = asuint64 (x) & -1ULL >> 1;
+  uint64_t iy = asuint64 (y) & -1ULL >> 1;
+  uint32_t topx = ix >> 52;
+  uint32_t topy = iy >> 52;
+  uint32_t swap, xneg = asuint64 (x) >> 63;
+
+  if (unlikely (atan2_special (topx) || atan2_special (topy)))
+    return specialcase (y, x, topx, topy);
+
+  swap = iy > ix;
+  p = asfloat64 (swap ? ix : iy);
+  q = asfloat64 (swap ? iy : ix);
+  inv = 1.0 / q;
+  r = p * inv;
+  if (unlikely (r < 0x1p-4))
+    {
+      /* atan (p/q) is r plus the rounding error of r and the
+	 polynomial.  */
+      hi = atan_mul (r, q, &e);
+      lo = ((p - hi) - e) * inv + atan_poly1 (r);
+      hi = r;
+    }
+  else
+    hi = atan_inline (p, q, r, &lo);
+  /* atan2 is atan (ay/ax), PI/2 - atan (ax/ay), PI - atan (ay/ax) or
+     PI/2 + atan (ax/ay) depending on the quadrant.  */
+  hi = atan_quadrant (swap | (xneg & ~swap) << 1, swap ^ xneg, hi, lo);
+  return asfloat64 (asuint64 (hi) ^ (asuint64 (y) & 1ULL << 63));
+}
+
+_MATH_ALIAS_d_dd(atan2)
+
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,83 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_FLOAT
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+#include "atan.h"
+
+/* Table-driven atan2f, evaluated in double precision.  */
+float
+atan2f (float y, float x)
+{
+  uint32_t ix = asuint (x) & 0x7fffffff;
+  uint32_t iy = asuint (y) & 0x7fffffff;
+  int xneg = asuint (x) >> 31;
+  double_t r;
+
+  if (unlikely (ix > asuint (INFINITY) || iy > asuint (INFINITY)))
+    return x + y;
+  if (unlikely (iy == 0))
+    {
+      /* atan2f (+-0, x) is +-0 for x > 0 or +0, +-PI otherwise.  */
+      if (!xneg)
+	return y;
+      r = 2.0 * Pio2hi;
+    }
+  else if (unlikely (ix == asuint (INFINITY) && iy == asuint (INFINITY)))
+    /* +-PI/4 or +-3PI/4.  */
+    r = (xneg ? 3.0 : 1.0) * (0.5 * Pio2hi);
+  else if (unlikely (ix == 0))
+    /* Avoid dividing by zero below.  */
+    r = Pio2hi;
+  else
+    {
+      /* The quotient is accurate to double precision and may be zero
+	 or infinite.  */
+      r = atanf_inline (fabs ((double_t) y) / fabs ((double_t) x));
+      if (xneg)
+	r = 2.0 * Pio2hi - r;
+      else if (ix != asuint (INFINITY))
+	r = check_uflowf ((float) r);
+    }
+  return (float) (asuint (y) >> 31 ? -r : r);
+}
+
+_MATH_ALIAS_f_ff(atan2)
+
+#endif /* __OBSOLETE_MATH_FLOAT */
@@ -0,0 +1,321 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE || !__OBSOLETE_MATH_FLOAT
+
+#include "math_config.h"
+#include "atan.h"
+
+const struct atan_data __atan_data = {
+.pio2hi = 0x1.921fb54442d18p+0,
+.pio2lo = 0x1.1a62633145c07p-54,
+// Taylor coefficients.  With |t| < 2^-7 the truncation error is below
+// 2^-66.
+.poly = {
+-0x1.5555555555555p-2,
+0x1.999999999999ap-3,
+-0x1.2492492492492p-3,
+},
+// Taylor coefficients with the z^13 term economized over |z| < 2^-4.
+// The relative error is below 2^-59.
+.poly1 = {
+-0x1.55555555554e5p-2,
+0x1.999999992999ap-3,
+-0x1.249247a492492p-3,
+0x1.c71771c71c71cp-4,
+-0x1.705d1745d1746p-4,
+},
+// atan (C) where C = 2^k * (1 + (j + 1/2)/32), k = -4 .. 3, j = 0 .. 31
+.tab = {
+0x1.03a6d1c06693dp-4, -0x1.28a02d4e7f128p-59,
+0x1.0b9e589974c5ap-4, -0x1.f562f8f82aa7dp-58,
+0x1.13955a967a682p-4, -0x1.f14bea29d48ep-61,
+0x1.1b8bd3d2450b4p-4, 0x1.c702f55f40ca1p-59,
+0x1.2381c06936f53p-4, -0x1.13ab02fa49b2ep-63,
+0x1.2b771c79524f9p-4, 0x1.801865d4fe38cp-59,
+0x1.336be4224448fp-4, -0x1.896ec408970edp-60,
+0x1.3b6013857029ap-4, 0x1.cef69c598d117p-58,
+0x1.4353a6c5fa5c9p-4, -0x1.89ca24296786ep-59,
+0x1.4b469a08d36a9p-4, -0x1.67764362ac8f8p-58,
+0x1.5338e974c2e93p-4, 0x1.e3eb6e1a3217fp-59,
+0x1.5b2a9132725bep-4, 0x1.b5aecdb976688p-58,
+0x1.631b8d6c78073p-4, 0x1.5354364311097p-59,
+0x1.6b0bda4f61b64p-4, -0x1.66f174309c437p-59,
+0x1.72fb7409bf71ep-4, -0x1.49e8cee5bd0b1p-59,
+0x1.7aea56cc2e292p-4, 0x1.862457b637cc2p-60,
+0x1.82d87ec9624bp-4, -0x1.8e7fb5a543bbp-58,
+0x1.8ac5e8363250cp-4, 0x1.15e9ba2458c7ep-60,
+0x1.92b28f49a1396p-4, -0x1.60caf880fe33ap-59,
+0x1.9a9e703ce8f4bp-4, 0x1.8accc68654f4fp-60,
+0x1.a289874b84bf2p-4, -0x1.31bef7bb27f28p-61,
+0x1.aa73d0b33b6cdp-4, 0x1.5b002aaa42a3p-60,
+0x1.b25d48b429a49p-4, -0x1.32a746bf9f0c9p-59,
+0x1.ba45eb90cc09dp-4, -0x1.be60b2305d50cp-60,
+0x1.c22db58e0955ep-4, -0x1.da77163bcbeb1p-60,
+0x1.ca14a2f33c5fcp-4, -0x1.7bc7bff4e21fp-58,
+0x1.d1fab00a3e127p-4, 0x1.c52e600069ec6p-58,
+0x1.d9dfd91f6f51fp-4, -0x1.e373b96f9eb44p-62,
+0x1.e1c41a81c2cd8p-4, -0x1.b57cf1ad863e1p-58,
+0x1.e9a77082c6c06p-4, 0x1.f815918969092p-58,
+0x1.f189d776aea02p-4, 0x1.42f42239afc9fp-60,
+0x1.f96b4bb45cb78p-4, 0x1.959967d6ab75cp-58,
+0x1.029dd57ffc493p-3, 0x1.bb733fef67d21p-57,
+0x1.0a7c5b4bed20fp-3, 0x1.f457784a8f1bfp-58,
+0x1.1258daff330b4p-3, -0x1.cc20745a0cfb6p-57,
+0x1.1a334638df0d3p-3, 0x1.7c21ed490212ap-61,
+0x1.220b8eafa5aa3p-3, -0x1.93591d26d74e6p-57,
+0x1.29e1a6326d7d6p-3, -0x1.b5e247c97cf1cp-63,
+0x1.31b57ea8db38dp-3, -0x1.5d0ace29c16e7p-58,
+0x1.39870a13dafd5p-3, -0x1.37bc555c15fc9p-58,
+0x1.41563a8e2700dp-3, 0x1.82b19fb0fe39ap-57,
+0x1.4923024ccb781p-3, -0x1.4b03a2a563a86p-60,
+0x1.50ed539fa7b92p-3, 0x1.549cad441d287p-58,
+0x1.58b520f1ec8e1p-3, 0x1.439f6976f6aeap-58,
+0x1.607a5cca97ad8p-3, -0x1.c54544fd7f472p-61,
+0x1.683cf9ccec514p-3, 0x1.f3bfa1da86535p-60,
+0x1.6ffceab8e8e2cp-3, 0x1.04f4eab9fef43p-58,
+0x1.77ba226bb9b5ap-3, -0x1.eaab479a54c1cp-59,
+0x1.7f7493e028c98p-3, -0x1.c2e8749cc2864p-59,
+0x1.872c322f0a8ccp-3, 0x1.3c6ab3a279db5p-57,
+0x1.8ee0f08fa79a2p-3, -0x1.c1202c9d89e1ap-58,
+0x1.9692c258236b8p-3, 0x1.a4df32027b323p-57,
+0x1.9e419afddffe1p-3, 0x1.9bef44b11a7d6p-58,
+0x1.a5ed6e15de61fp-3, -0x1.62b7dbf5e947dp-58,
+0x1.ad962f551c32fp-3, 0x1.8c8a0fe2eca7dp-59,
+0x1.b53bd290edf69p-3, -0x1.728a826d84c42p-58,
+0x1.bcde4bbf565c2p-3, 0x1.1a596894e1206p-58,
+0x1.c47d8ef75a5dcp-3, -0x1.4bd193c203f92p-57,
+0x1.cc199071523f5p-3, 0x1.3020e52d5fdccp-62,
+0x1.d3b24487376b7p-3, 0x1.d4aa195dd7fb3p-59,
+0x1.db479fb4ef2c9p-3, 0x1.cecf00dd15008p-57,
+0x1.e2d996989242ep-3, 0x1.19c5b7c3b998cp-57,
+0x1.ea681df2b156bp-3, -0x1.b195eb5b69f8ep-57,
+0x1.f1f32aa696486p-3, -0x1.9cc87998a8041p-58,
+0x1.fd3d1fc40dbe4p-3, 0x1.37146f3a1c5eap-59,
+0x1.061eea03d6291p-2, -0x1.5f760db154301p-59,
+0x1.0d97ee509acb3p-2, 0x1.47c317bd5a3ebp-56,
+0x1.150973a9ce547p-2, -0x1.796ba7f9ca328p-56,
+0x1.1c735212dd884p-2, -0x1.7d9ac78cb2f2ep-57,
+0x1.23d562b381042p-2, -0x1.c531716200088p-58,
+0x1.2b2f7fd9b5fe2p-2, 0x1.423cfc1c2d443p-61,
+0x1.328184fb58952p-2, -0x1.a95f0a9939f2fp-56,
+0x1.39cb4eb76157cp-2, -0x1.2f4da5a214713p-56,
+0x1.410cbad6c7d33p-2, -0x1.b0c8bae13b512p-56,
+0x1.4845a84d0c21bp-2, 0x1.1e28a7563c6a6p-56,
+0x1.4f75f73869979p-2, -0x1.95a1cf7ff1108p-58,
+0x1.569d88e1b4cd8p-2, -0x1.fec61e713cfe2p-57,
+0x1.5dbc3fbbe768dp-2, 0x1.ea0ec1b76f7dap-57,
+0x1.64d1ff635c1c6p-2, -0x1.fa403e7c0fdbep-56,
+0x1.6bdeac9cbd76dp-2, -0x1.a5c563e6de828p-58,
+0x1.72e22d53aa2aap-2, -0x1.d9c934e79f27cp-56,
+0x1.79dc6899118d1p-2, 0x1.b7413a0ef606dp-61,
+0x1.80cd46a14b1d1p-2, -0x1.e79f99684fa19p-56,
+0x1.87b4b0c1ebedcp-2, -0x1.6dcfaa2fa470fp-56,
+0x1.8e92916f5cde8p-2, 0x1.4c0a7e12bfafbp-56,
+0x1.9566d43a34907p-2, 0x1.9b01537e0af2bp-57,
+0x1.9c3165cc58107p-2, 0x1.b669602250cfbp-59,
+0x1.a2f233e5e530bp-2, 0x1.814d5f797086bp-58,
+0x1.a9a92d59e98cfp-2, 0x1.2e42dff75d817p-59,
+0x1.b056420ae9344p-2, -0x1.9313946363455p-56,
+0x1.b6f962e737efcp-2, -0x1.ca53464981e71p-58,
+0x1.bd9281e528192p-2, -0x1.4b15439af6b66p-56,
+0x1.c42191ff11eb7p-2, -0x1.b17df434b3eeep-56,
+0x1.caa6872f3631bp-2, 0x1.9506781636f48p-61,
+0x1.d121566b7f2adp-2, 0x1.be67835886c3p-56,
+0x1.d791f5a1226f5p-2, -0x1.4017ea5b64a76p-57,
+0x1.e127b6b0744bp-2, -0x1.2b0986398d4abp-58,
+0x1.edcb6d43f8435p-2, -0x1.fc976330884e4p-58,
+0x1.fa45dd3029259p-2, -0x1.ca563dc28d8b5p-56,
+0x1.034b709250488p-1, 0x1.8f9b38d85541p-56,
+0x1.095f30861a59p-1, -0x1.121b20a15a9f3p-56,
+0x1.0f5e28b67e295p-1, 0x1.311b17ec990dp-65,
+0x1.154859637646ap-1, -0x1.4ba7c548bf3c3p-55,
+0x1.1b1dc87904285p-1, -0x1.21e8c8aef8f29p-57,
+0x1.20de813e823b2p-1, -0x1.791d753ebb744p-55,
+0x1.268a940696da6p-1, 0x1.d1348a04c73ccp-58,
+0x1.2c2215e024466p-1, -0x1.4b810da3a4be1p-59,
+0x1.31a52048874bep-1, 0x1.40cab87a7ac24p-55,
+0x1.3713d0df6c504p-1, -0x1.4f789e031606dp-58,
+0x1.3c6e491c78dc5p-1, -0x1.e145094fd0ba7p-55,
+0x1.41b4ae06fea41p-1, 0x1.3d60a53277652p-57,
+0x1.46e727efe4716p-1, -0x1.39b9b1b844cc9p-57,
+0x1.4c05e22de94e5p-1, -0x1.c0ac1f09f2edfp-55,
+0x1.51110adc5ed81p-1, 0x1.23dcd6832a63ep-56,
+0x1.5608d29c70c34p-1, 0x1.9939cf0de8088p-55,
+0x1.5aed6c5909517p-1, 0x1.7312f714a9436p-55,
+0x1.5fbf0d0d5cc4ap-1, -0x1.b4cfd000b7158p-58,
+0x1.647deb8e20b9p-1, -0x1.eca04023a51cfp-58,
+0x1.692a40556fb6ap-1, 0x1.d94b95a8ea2ccp-55,
+0x1.6dc44551553afp-1, -0x1.bf8863573828ep-58,
+0x1.724c35b4fae7bp-1, 0x1.948b32db3499bp-58,
+0x1.76c24dcc6c6cp-1, 0x1.1952551adc83dp-55,
+0x1.7b26cad2e50fep-1, -0x1.ce80df30411fbp-55,
+0x1.7f79eacb97898p-1, 0x1.fd5ca80ead221p-55,
+0x1.83bbec5cdee22p-1, 0x1.3107104ffc6c3p-57,
+0x1.87ed0eadc5a2ap-1, 0x1.0af5ad957f4bcp-56,
+0x1.8c0d9145cf49dp-1, 0x1.bea4076dc4333p-55,
+0x1.901db3eeef187p-1, 0x1.68665e5603c8fp-55,
+0x1.9617bfeebaf28p-1, 0x1.0032c8866f9b2p-56,
+0x1.9dd8d51585769p-1, -0x1.ae877ffec0468p-55,
+0x1.a55ce84fecd16p-1, -0x1.21ee7dfa97e23p-55,
+0x1.aca5f3f19ab96p-1, 0x1.e8e23fc4ff624p-55,
+0x1.b3b5ec3794397p-1, -0x1.2985d9907b08p-55,
+0x1.ba8ebd7c5a191p-1, 0x1.e58aede56b11ep-55,
+0x1.c1324abe8915dp-1, 0x1.5de7930719b2p-61,
+0x1.c7a26c706c612p-1, -0x1.09a8c1f8a4817p-56,
+0x1.cde0ef87a615dp-1, 0x1.88b5df85eda52p-56,
+0x1.d3ef94c4cabf9p-1, 0x1.ea50304a31a71p-57,
+0x1.d9d0102b87e53p-1, 0x1.9dff587921d15p-55,
+0x1.df8408a4a4bf5p-1, 0x1.0f428b385436fp-55,
+0x1.e50d17c3dc497p-1, -0x1.844a35b61a4b4p-55,
+0x1.ea6cc9ac363efp-1, 0x1.64f83238896e5p-58,
+0x1.efa49d0e1fcefp-1, 0x1.85c3eaf843caap-55,
+0x1.f4b6033b14105p-1, -0x1.c5354f363c7eep-58,
+0x1.f9a2604b273d7p-1, 0x1.59fb0e0020faap-55,
+0x1.fe6b0b513e96ap-1, -0x1.82c681ffe40a2p-56,
+0x1.0188a74d94efcp+0, -0x1.de8df32afb52dp-54,
+0x1.03cb33fd99ad1p+0, 0x1.97daa58fd9fa9p-54,
+0x1.05fdc48c884c5p+0, 0x1.1c07d0e3c54p-54,
+0x1.0820ebe435222p+0, -0x1.f36f8ddb2aea1p-54,
+0x1.0a353731b9f23p+0, 0x1.95b45bbe0eb51p-55,
+0x1.0c3b2e1423c0fp+0, -0x1.ac7ddfb7312b5p-55,
+0x1.0e3352cbf645p+0, -0x1.4e55e38fb33bp-54,
+0x1.101e226b0f2b4p+0, -0x1.ca14e83b1fd9ap-55,
+0x1.11fc150486eeap+0, 0x1.b640c9c014a5ap-54,
+0x1.13cd9ddc3dfe6p+0, 0x1.00949f8187484p-56,
+0x1.15932b95d395fp+0, -0x1.ba87ea99b85f1p-54,
+0x1.174d2862d04ccp+0, 0x1.dff7f9a86ea82p-54,
+0x1.18fbfa2fd93b8p+0, 0x1.6fe2c91a1ae8dp-55,
+0x1.1aa002d0c9dabp+0, 0x1.b3a673c04199ap-55,
+0x1.1d02a2edce14fp+0, 0x1.d0a3b2bae2099p-56,
+0x1.200e5ae0dd61dp+0, 0x1.bed3cdd901e18p-55,
+0x1.22f5127ff70b5p+0, 0x1.4a430e2d0a41ep-55,
+0x1.25b92ee2f7a49p+0, -0x1.75e638d53460ap-54,
+0x1.285ce59c9732p+0, -0x1.75b26f6f4d78fp-54,
+0x1.2ae240bd32395p+0, -0x1.fd6bc679da199p-54,
+0x1.2d4b22823a35cp+0, 0x1.cf7b124d9fd08p-56,
+0x1.2f9948b6a1b4cp+0, 0x1.22febbf47b08p-55,
+0x1.31ce4fc931347p+0, 0x1.39a6d04c1b60bp-54,
+0x1.33ebb59df782bp+0, -0x1.02b3d3b7bf8dcp-54,
+0x1.35f2dc20141bbp+0, -0x1.f41f13d3ea682p-54,
+0x1.37e50b98fe91cp+0, 0x1.7c4f65ff85e9ep-54,
+0x1.39c374d238f7bp+0, -0x1.0e10bce7c08c4p-57,
+0x1.3b8f3306167a9p+0, -0x1.15725c9547d04p-54,
+0x1.3d494da3f1dcap+0, -0x1.39e5cc1bf2c1bp-54,
+0x1.3ef2b9ebde493p+0, 0x1.0ab7d20ab732ap-54,
+0x1.408c5c658b763p+0, -0x1.c066d31f57e75p-55,
+0x1.42170a35c681ap+0, 0x1.e5c774907e6dbp-55,
+0x1.43938a55b4f1dp+0, 0x1.1ff9682e290acp-54,
+0x1.450296ae9f949p+0, -0x1.cfd6fc36c6974p-54,
+0x1.4664dd1ce02f9p+0, 0x1.38ecc63a07d2dp-54,
+0x1.47bb005c4732dp+0, 0x1.a2f98d0b4820dp-54,
+0x1.490598e015e2ep+0, 0x1.e07def52831b8p-54,
+0x1.4a453598759cp+0, -0x1.666bc3f7a196ep-55,
+0x1.4b7a5ca7259aap+0, -0x1.ec80f282dc46p-54,
+0x1.4ca58c04ede32p+0, 0x1.144de97a969fcp-55,
+0x1.4dc73a193f1b4p+0, 0x1.12518d76d3566p-54,
+0x1.4edfd645441e7p+0, -0x1.f67eaeec21278p-54,
+0x1.4fefc9638a79fp+0, 0x1.ca0501d485c89p-54,
+0x1.50f7763d4a801p+0, -0x1.d0bda250c54e3p-54,
+0x1.51f739f63df6ap+0, -0x1.34fffe9d872fbp-54,
+0x1.52ef6c6fdd517p+0, -0x1.ef7a6346bb398p-54,
+0x1.54563c118794cp+0, 0x1.dcf885269164p-54,
+0x1.561d0ad75b853p+0, -0x1.3c563b0cd09ecp-61,
+0x1.57cade57dba51p+0, -0x1.8b8666c0ed546p-60,
+0x1.5961aeac184b3p+0, -0x1.ae4b95d52e176p-54,
+0x1.5ae3412f1c467p+0, 0x1.41f255fc8a11ap-54,
+0x1.5c512e9c5bb9fp+0, -0x1.cf8fbd02712bep-54,
+0x1.5dace854dff1cp+0, 0x1.73f5a5a50fadfp-59,
+0x1.5ef7bcecde57ap+0, 0x1.c1fc96bde482ap-54,
+0x1.6032dc1db31f6p+0, -0x1.90a89eba7946cp-55,
+0x1.615f5a338cc04p+0, 0x1.a791fa40522aap-54,
+0x1.627e330a40ae9p+0, 0x1.2a8b12af9f40bp-58,
+0x1.63904ca99b192p+0, 0x1.0637e25b5a21fp-57,
+0x1.6496798ee1ec5p+0, -0x1.62b32e1c7b9dbp-56,
+0x1.65917aaf1caa2p+0, -0x1.90c4cafa9df2p-54,
+0x1.6682013be9a64p+0, -0x1.9479fbb399bacp-58,
+0x1.6768b0332cd22p+0, -0x1.053d6aa6ae0b1p-54,
+0x1.68461dc0a6bc7p+0, -0x1.d5023b5c99699p-54,
+0x1.691ad47778958p+0, 0x1.6446b89f76d5bp-54,
+0x1.69e75468badcdp+0, 0x1.f296eed20e524p-55,
+0x1.6aac141b90791p+0, -0x1.ae605e48c3e5ap-54,
+0x1.6b69816a8160fp+0, -0x1.acc41f3aad1cbp-55,
+0x1.6c20024961b81p+0, 0x1.f035f98c5e92dp-54,
+0x1.6ccff57698526p+0, 0x1.495b739d3b0cfp-56,
+0x1.6d79b31a369dfp+0, -0x1.81895cac911d7p-54,
+0x1.6e1d8d5501419p+0, 0x1.cb5ebec61d812p-54,
+0x1.6ebbd0c142077p+0, 0x1.1366b90f3db0bp-55,
+0x1.6f54c4e6ff0e5p+0, -0x1.2c3eb2e5d4742p-54,
+0x1.6fe8aca4ff2b9p+0, 0x1.aca07cf67f4ccp-54,
+0x1.7077c68fd68fcp+0, -0x1.0b6cc09dfda37p-55,
+0x1.71024d48100cfp+0, -0x1.29dfd27c252d8p-54,
+0x1.718877c865e8ap+0, 0x1.668bdc523dcecp-54,
+0x1.720a79ace01eep+0, 0x1.969999e452063p-54,
+0x1.72c619a79eb51p+0, -0x1.f7e5d0ba64e0dp-54,
+0x1.73b36322e5a78p+0, -0x1.b27f69dd145cap-54,
+0x1.74931b40e6089p+0, 0x1.3b1ccbff02344p-54,
+0x1.7566626754235p+0, -0x1.79b006f7943c1p-54,
+0x1.762e3a0ad27dbp+0, 0x1.0fce0b5e61c3ep-54,
+0x1.76eb88b56e0e1p+0, -0x1.6e6b9d43c04eap-56,
+0x1.779f1d70e8bfdp+0, -0x1.282f0950761e8p-55,
+0x1.7849b2afa9392p+0, 0x1.03bfbbf57e392p-54,
+0x1.78ebf0ca06a41p+0, 0x1.a55484f48da49p-54,
+0x1.798670219969dp+0, 0x1.78e1236d13372p-56,
+0x1.7a19baf900435p+0, -0x1.f45ce761c29b9p-56,
+0x1.7aa64f0bf4bbep+0, 0x1.7d1bd08e87443p-54,
+0x1.7b2c9ef177685p+0, 0x1.ce4853ff4e5a8p-58,
+0x1.7bad13502f261p+0, -0x1.033d85ad876a7p-54,
+0x1.7c280bebba7a6p+0, -0x1.ef3f029f07962p-54,
+0x1.7c9de0909622ap+0, -0x1.df66031923dd3p-55,
+0x1.7d0ee1e3533e4p+0, -0x1.f0838cccc1413p-55,
+0x1.7d7b5a1718148p+0, 0x1.00655b0b0e0b2p-57,
+0x1.7de38d8ec8635p+0, 0x1.4d61badd75b84p-55,
+0x1.7e47bb6baf0f3p+0, -0x1.17f759533be11p-54,
+0x1.7ea81e0c15f4ap+0, 0x1.7d7da6fa30a02p-54,
+0x1.7f04eb7bdd7dp+0, 0x1.4ec9fb8a41b13p-54,
+0x1.7f5e55d8d9377p+0, -0x1.6fd26c21f97a7p-54,
+0x1.7fb48bac767e9p+0, 0x1.23de9f42ff0c2p-54,
+0x1.8007b83bfc04p+0, -0x1.4e96acfd0c2aep-57,
+0x1.805803d0833eap+0, -0x1.527c3fb90a325p-61,
+0x1.80a593f7a5dp+0, 0x1.c60b1e17effadp-56,
+0x1.80f08bbdb7d12p+0, -0x1.4827d93ae77aap-57,
+0x1.81390be24bb09p+0, -0x1.0577a17c47468p-54,
+0x1.817f3307a416ep+0, -0x1.71f4e2a83101ap-54,
+0x1.81c31ddda3809p+0, -0x1.6cc7075443c24p-56,
+0x1.8204e748b75e2p+0, -0x1.2aa5b7c905744p-54,
+},
+};
+#endif /* !__OBSOLETE_MATH_DOUBLE || !__OBSOLETE_MATH_FLOAT */
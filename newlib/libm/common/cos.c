@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* Table-driven cos for 3PI/4 <= |x| < 2^16, evaluated as sin (x + PI/2)
+   by offsetting the table index.  Other arguments use the fdlibm
+   kernels as in sin.  */
+double
+cos (double x)
+{
+  double_t r[2], hi, lo;
+  uint32_t top = abstop32 (x);
+  uint32_t abstop = abstop12 (x);
+  uint32_t n;
+
+  if (likely (top <= SINCOS_PIO4))
+    return __kernel_cos (x, 0.0);
+  if (top < SINCOS_3PIO4)
+    {
+      /* cos (x) = -sin (|x| - PI/2).  */
+      sincos_sub (fabs (x), SINCOS_N / 4, r);
+      return -__kernel_sin (r[0], r[1], 1);
+    }
+  if (unlikely (abstop >= SINCOS_HUGE))
+    {
+      if (abstop >= abstop12 (INFINITY))
+	return __math_invalid (x);
+      return sincos_large (x, 1);
+    }
+
+  n = sincos_reduce (x, r);
+
+  hi = sincos_inline (n + SINCOS_N / 4, r[0], r[1], &lo);
+  return hi + lo;
+}
+
+#ifdef __strong_reference
+#if defined(__GNUCLIKE_PRAGMA_DIAGNOSTIC) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmissing-attributes"
+#endif
+__strong_reference(cos, _cos);
+#endif
+
+_MATH_ALIAS_d_d(cos)
+
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include <math.h>
+#include <stdint.h>
+#include "math_config.h"
+#include "sincos.h"
+
+/* Table-driven sincos, sharing one range reduction between the sin and
+   cos results.  */
+void
+sincos (double x, double *sinp, double *cosp)
+{
+  double_t r[2], hi, lo, s, c;
+  double y[2];
+  uint32_t top = abstop32 (x);
+  uint32_t abstop = abstop12 (x);
+  uint32_t n;
+
+  if (likely (top <= SINCOS_PIO4))
+    {
+      if (unlikely (top < 0x00100000))
+	/* Force underflow for tiny x.  */
+	force_eval_double (x * x);
+      *sinp = __kernel_sin (x, 0.0, 0);
+      *cosp = __kernel_cos (x, 0.0);
+      return;
+    }
+  if (top < SINCOS_3PIO4)
+    {
+      /* As in sin and cos, from |x| - PI/2.  */
+      sincos_sub (fabs (x), SINCOS_N / 4, r);
+      s = __kernel_cos (r[0], r[1]);
+      *sinp = x < 0 ? -s : s;
+      *cosp = -__kernel_sin (r[0], r[1], 1);
+      return;
+    }
+  if (unlikely (abstop >= SINCOS_HUGE))
+    {
+      if (abstop >= abstop12 (INFINITY))
+	{
+	  *sinp = *cosp = __math_invalid (x);
+	  return;
+	}
+      /* As for sin and cos, finish with the fdlibm kernels.  */
+      n = __rem_pio2 (x, y);
+      s = __kernel_sin (y[0], y[1], 1);
+      c = __kernel_cos (y[0], y[1]);
+      if (n & 1)
+	{
+	  double_t t = s;
+	  s = c;
+	  c = -t;
+	}
+      if (n & 2)
+	{
+	  s = -s;
+	  c = -c;
+	}
+      *sinp = s;
+      *cosp = c;
+      return;
+    }
+
+  n = sincos_reduce (x, r);
+
+  hi = sincos_inline (n, r[0], r[1], &lo);
+  *sinp = hi + lo;
+  hi = sincos_inline (n + SINCOS_N / 4, r[0], r[1], &lo);
+  *cosp = hi + lo;
+}
+
+_MATH_ALIAS_v_dDD(sincos)
+
+#endif /* __OBSOLETE_MATH_DOUBLE */
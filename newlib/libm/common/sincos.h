@@ -0,0 +1,274 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Shared pieces of the double precision sin, cos and sincos functions.
+
+   Up to PI/4 the fdlibm kernels are used directly, and up to 3PI/4
+   they are applied to |X| - PI/2.  Above that X is reduced to X = N * PI/32 + R with |R| <= PI/64, then
+
+	sin (X) = S * cos (R) + C * sin (R)
+
+   where S = sin (N * PI/32) and C = cos (N * PI/32) = sin ((N + 16) * PI/32)
+   come from a table covering a full period, each entry stored as a
+   pair of doubles so that the leading term is exact.  cos (X) uses the
+   same code with N + 16, so neither needs to select a quadrant.  Short
+   polynomials cover sin (R) and cos (R) - 1.
+
+   Near multiples of PI, where the result is small, S * cos (R) and
+   C * sin (R) cancel, so there the argument is instead reduced to
+   |Y| <= 3PI/64 and sin (Y) is evaluated with a longer polynomial.
+
+   From 2^16 up the reduction is done by __rem_pio2 and the result
+   again comes from the fdlibm kernels.  */
+
+#ifndef _SINCOS_H_
+#define _SINCOS_H_
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+#define SINCOS_TABLE_BITS 6
+#define SINCOS_N (1 << SINCOS_TABLE_BITS)
+
+extern const struct sincos_data
+{
+  double invpio32;		/* 32/PI.  */
+  double shift;			/* 0x1.8p52.  */
+  double pio32_1, pio32_2, pio32_3;	/* PI/32 in 33 bit pieces.  */
+  double pio32_1t;		/* PI/32 - pio32_1.  */
+  double pio32_3t;		/* PI/32 - (pio32_1 + pio32_2 + pio32_3).  */
+  double pio32hi, pio32lo;	/* PI/32 with k * pio32hi exact for |k| <= 8.  */
+  double sin_poly[5];		/* sin (r) - r = r^3 * P (r^2).  */
+  double cos_poly[3];		/* cos (r) - 1 + r^2/2 = r^4 * Q (r^2).  */
+  /* sin (i * PI/32) as pairs of doubles, the first rounded to 26 bits so
+     that its product with a 27 bit number is exact.  */
+  double tab[2 * SINCOS_N];
+} __sincos_data HIDDEN;
+
+#define InvPio32 __sincos_data.invpio32
+#define Shift __sincos_data.shift
+#define Pio32_1 __sincos_data.pio32_1
+#define Pio32_1t __sincos_data.pio32_1t
+#define Pio32_2 __sincos_data.pio32_2
+#define Pio32_3 __sincos_data.pio32_3
+#define Pio32_3t __sincos_data.pio32_3t
+#define Pio32hi __sincos_data.pio32hi
+#define Pio32lo __sincos_data.pio32lo
+#define S3 __sincos_data.sin_poly[0]
+#define S5 __sincos_data.sin_poly[1]
+#define S7 __sincos_data.sin_poly[2]
+#define S9 __sincos_data.sin_poly[3]
+#define S11 __sincos_data.sin_poly[4]
+#define C4 __sincos_data.cos_poly[0]
+#define C6 __sincos_data.cos_poly[1]
+#define C8 __sincos_data.cos_poly[2]
+#define T __sincos_data.tab
+
+/* Top 12 bits of the double representation with the sign bit cleared.  */
+static inline uint32_t
+abstop12 (double x)
+{
+  return (asuint64 (x) >> 52) & 0x7ff;
+}
+
+/* Top 32 bits of the double representation with the sign bit cleared.  */
+static inline uint32_t
+abstop32 (double x)
+{
+  return (asuint64 (x) >> 32) & 0x7fffffff;
+}
+
+/* Inputs up to SINCOS_PIO4 need no reduction and go straight to the
+   fdlibm polynomials in __kernel_sin and __kernel_cos, which are
+   cheaper than the table there.  Below SINCOS_3PIO4 the same kernels
+   are used after subtracting PI/2.  From SINCOS_HUGE up __rem_pio2 is
+   used.  */
+#define SINCOS_PIO4 0x3fe921fb
+#define SINCOS_3PIO4 0x4002d97c
+#define SINCOS_HUGE abstop12 (0x1p16)
+
+/* Return the multiple N of PI/32 nearest to X and store it as a double
+   in *KD.  In rounding modes other than to nearest N may be off by one,
+   giving a reduced argument of up to PI/32.  */
+static inline uint32_t
+sincos_round (double_t x, double_t *kd)
+{
+  double_t z = x * InvPio32;
+#if TOINT_INTRINSICS
+  *kd = roundtoint (z);
+  return converttoint (z);
+#else
+  /* Adding Shift leaves z rounded to an integer in the low bits.  */
+  double_t k = eval_as_double (z + Shift);
+  *kd = k - Shift;
+  return asuint64 (k);
+#endif
+}
+
+/* Set R[0] + R[1] = X - KD * PI/32, where KD is an integer with
+   |KD| < 2^20 and KD * PI/32 within a factor of two of X, so that the
+   products with the 33 bit pieces of PI/32 and the first subtraction
+   are exact.  The result is accurate to about 2^-70, or 2^-120 when X
+   is close enough to KD * PI/32 for that not to be sufficient.  */
+static inline void
+sincos_sub (double_t x, double_t kd, double_t *r)
+{
+  double_t a, b, s, t, e;
+
+  /* Exact as kd * Pio32_1 is within a factor of two of x.  */
+  a = x - kd * Pio32_1;
+  if (likely (abstop12 (a) >= abstop12 (0x1p-10)))
+    {
+      /* |kd * Pio32_1t| < 2^-18, so this is a fast two sum.  */
+      b = kd * Pio32_1t;
+      r[0] = a - b;
+      r[1] = (a - r[0]) - b;
+      return;
+    }
+  /* Subtract the remaining pieces using compensated sums.  */
+  b = kd * Pio32_2;
+  s = a - b;
+  t = s - a;
+  e = (a - (s - t)) - (b + t);
+  a = s;
+  b = kd * Pio32_3;
+  s = a - b;
+  t = s - a;
+  e += (a - (s - t)) - (b + t);
+  e -= kd * Pio32_3t;
+  r[0] = s + e;
+  r[1] = (s - r[0]) + e;
+}
+
+/* Reduce X to R[0] + R[1] = X - N * PI/32 with |R[0] + R[1]| <= PI/64
+   and return N.  |X| must be in [2^-4, 2^16) so that N fits in 20 bits
+   and sincos_sub applies even when N is off by one.  */
+static inline uint32_t
+sincos_reduce (double_t x, double_t *r)
+{
+  double_t kd;
+  uint32_t n = sincos_round (x, &kd);
+
+  sincos_sub (x, kd, r);
+  return n;
+}
+
+/* Return sin (X + Q * PI/2) for |X| >= 2^16.  __rem_pio2 dominates the
+   cost there, so finish with the fdlibm kernels rather than reducing
+   the result again for the table.  */
+static inline double
+sincos_large (double x, uint32_t q)
+{
+  double y[2], r;
+  uint32_t n = __rem_pio2 (x, y) + q;
+
+  if (n & 1)
+    r = __kernel_cos (y[0], y[1]);
+  else
+    r = __kernel_sin (y[0], y[1], 1);
+  return n & 2 ? -r : r;
+}
+
+/* Compute sin (N * PI/32 + R0 + R1) for |R0 + R1| <= PI/32 and
+   |R1| <= ulp (R0) / 2, returning the result as the sum of the return
+   value and *LO, with |*LO| much smaller than the return value.  This
+   is always inlined so that callers evaluating both sin and cos share
+   the polynomials.  */
+static __always_inline double_t
+sincos_inline (uint32_t n, double_t r0, double_t r1, double_t *lo)
+{
+  double_t z, z2, s, c, sh, sl, ch, cl, p, pe, hi, t;
+  uint32_t i = n % SINCOS_N;
+  uint32_t j = (n + 1) % (SINCOS_N / 2);
+
+  z = r0 * r0;
+  z2 = z * z;
+  s = r0 * z * ((S3 + z * S5) + z2 * (S7 + z * S9));
+  c = -0.5 * z + z2 * ((C4 + z * C6) + z2 * C8);
+
+  if (unlikely (j <= 2))
+    {
+      /* Close to a multiple of PI, use Y = R + (J - 1) * PI/32.  */
+      double_t kd = (double_t) ((int32_t) j - 1);
+      double_t y0, y1, yh = kd * Pio32hi;
+
+      y0 = yh + r0;
+      y1 = ((yh - y0) + r0) + (r1 + kd * Pio32lo);
+      z = y0 * y0;
+      z2 = z * z;
+      /* The y1 * (cos (y0) - 1) term matters as y0 may be as large as
+	 0.15.  */
+      y1 += z * (y0 * ((S3 + z * S5) + z2 * ((S7 + z * S9) + z2 * S11))
+		 - 0.5 * y1);
+      if ((n + 1) & (SINCOS_N / 2))
+	{
+	  y0 = -y0;
+	  y1 = -y1;
+	}
+      *lo = y1;
+      return y0;
+    }
+
+  sh = T[2 * i];
+  sl = T[2 * i + 1];
+  i = (i + SINCOS_N / 4) % SINCOS_N;
+  ch = T[2 * i];
+  cl = T[2 * i + 1];
+
+  /* S + C * r0 is the bulk of the result, add it exactly.  */
+#if __HAVE_FAST_FMA
+  p = ch * r0;
+  pe = fma (ch, r0, -p);
+#else
+  {
+    /* ch has only 26 significant bits, so its product with the top 27
+       bits of r0 is exact.  */
+    double_t rh = asfloat64 (asuint64 (r0) & -1ULL << 26);
+    p = ch * rh;
+    pe = ch * (r0 - rh);
+  }
+#endif
+  hi = sh + p;
+  /* The table heads are only 26 bits, use the full values in the
+     small terms.  Add the polynomials last as they take longest.  */
+  t = ((sh - hi) + p) + (pe + sl + cl * r0);
+  sh += sl;
+  ch += cl;
+  *lo = (t + ch * r1) + (ch * s + sh * c);
+  return hi;
+}
+
+#endif /* _SINCOS_H_ */
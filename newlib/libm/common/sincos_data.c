@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#if !__OBSOLETE_MATH_DOUBLE
+
+#include "math_config.h"
+#include "sincos.h"
+
+const struct sincos_data __sincos_data = {
+.invpio32 = 0x1.45f306dc9c883p+3,
+.shift = 0x1.8p52,
+// The same split as __rem_pio2 uses, scaled by 1/16
+.pio32_1 = 0x1.921fb544p-4,
+.pio32_1t = 0x1.0b4611a626331p-38,
+.pio32_2 = 0x1.0b4611a6p-38,
+.pio32_3 = 0x1.3198a2ep-73,
+.pio32_3t = 0x1.b839a252049c1p-108,
+.pio32hi = 0x1.921fb54442dp-4,
+.pio32lo = 0x1.8469898cc517p-52,
+// Taylor coefficients.  The truncation error is below 2^-61 relative
+// on the ranges they are used on, using only the first four terms of
+// the sin polynomial in the table-driven path.
+.sin_poly = {
+-0x1.5555555555555p-3,
+0x1.1111111111111p-7,
+-0x1.a01a01a01a01ap-13,
+0x1.71de3a556c734p-19,
+-0x1.ae64567f544e4p-26,
+},
+.cos_poly = {
+0x1.5555555555555p-5,
+-0x1.6c16c16c16c17p-10,
+0x1.a01a01a01a01ap-16,
+},
+// sin (i*PI/32), i = 0 .. 63
+.tab = {
+0x0p+0, 0x0p+0,
+0x1.917a6cp-4, -0x1.eb25ea0f138c7p-31,
+0x1.8f8b84p-3, -0x1.cb2cfaa4da337p-30,
+0x1.294063p-2, -0x1.2a60fa574a369p-30,
+0x1.87de2a8p-2, -0x1.51569d2e59dbap-30,
+0x1.e2b5d38p-2, 0x1.bd8ec78362475p-36,
+0x1.1c73b38p-1, 0x1.ae68c86c9774ap-29,
+0x1.44cf328p-1, -0x1.7b7114f3fc4afp-28,
+0x1.6a09e68p-1, -0x1.80c4336f74d05p-29,
+0x1.8bc8068p-1, 0x1.8a8ba05a743dap-28,
+0x1.a9b6628p-1, 0x1.0ea1a3033ec62p-29,
+0x1.c38b2fp-1, 0x1.80bdb0d23e9d1p-29,
+0x1.d906bdp-1, -0x1.9ae573aea067cp-30,
+0x1.e9f4158p-1, -0x1.39d225a27d387p-29,
+0x1.f6297dp-1, -0x1.1469faa77a357p-34,
+0x1.fd88dap-1, 0x1.e89292cf04139p-28,
+0x1p+0, 0x0p+0,
+0x1.fd88dap-1, 0x1.e89292cf04139p-28,
+0x1.f6297dp-1, -0x1.1469faa77a357p-34,
+0x1.e9f4158p-1, -0x1.39d225a27d387p-29,
+0x1.d906bdp-1, -0x1.9ae573aea067cp-30,
+0x1.c38b2fp-1, 0x1.80bdb0d23e9d1p-29,
+0x1.a9b6628p-1, 0x1.0ea1a3033ec62p-29,
+0x1.8bc8068p-1, 0x1.8a8ba05a743dap-28,
+0x1.6a09e68p-1, -0x1.80c4336f74d05p-29,
+0x1.44cf328p-1, -0x1.7b7114f3fc4afp-28,
+0x1.1c73b38p-1, 0x1.ae68c86c9774ap-29,
+0x1.e2b5d38p-2, 0x1.bd8ec78362475p-36,
+0x1.87de2a8p-2, -0x1.51569d2e59dbap-30,
+0x1.294063p-2, -0x1.2a60fa574a369p-30,
+0x1.8f8b84p-3, -0x1.cb2cfaa4da337p-30,
+0x1.917a6cp-4, -0x1.eb25ea0f138c7p-31,
+0x0p+0, 0x0p+0,
+-0x1.917a6cp-4, 0x1.eb25ea0f138c7p-31,
+-0x1.8f8b84p-3, 0x1.cb2cfaa4da337p-30,
+-0x1.294063p-2, 0x1.2a60fa574a369p-30,
+-0x1.87de2a8p-2, 0x1.51569d2e59dbap-30,
+-0x1.e2b5d38p-2, -0x1.bd8ec78362475p-36,
+-0x1.1c73b38p-1, -0x1.ae68c86c9774ap-29,
+-0x1.44cf328p-1, 0x1.7b7114f3fc4afp-28,
+-0x1.6a09e68p-1, 0x1.80c4336f74d05p-29,
+-0x1.8bc8068p-1, -0x1.8a8ba05a743dap-28,
+-0x1.a9b6628p-1, -0x1.0ea1a3033ec62p-29,
+-0x1.c38b2fp-1, -0x1.80bdb0d23e9d1p-29,
+-0x1.d906bdp-1, 0x1.9ae573aea067cp-30,
+-0x1.e9f4158p-1, 0x1.39d225a27d387p-29,
+-0x1.f6297dp-1, 0x1.1469faa77a357p-34,
+-0x1.fd88dap-1, -0x1.e89292cf04139p-28,
+-0x1p+0, 0x0p+0,
+-0x1.fd88dap-1, -0x1.e89292cf04139p-28,
+-0x1.f6297dp-1, 0x1.1469faa77a357p-34,
+-0x1.e9f4158p-1, 0x1.39d225a27d387p-29,
+-0x1.d906bdp-1, 0x1.9ae573aea067cp-30,
+-0x1.c38b2fp-1, -0x1.80bdb0d23e9d1p-29,
+-0x1.a9b6628p-1, -0x1.0ea1a3033ec62p-29,
+-0x1.8bc8068p-1, -0x1.8a8ba05a743dap-28,
+-0x1.6a09e68p-1, 0x1.80c4336f74d05p-29,
+-0x1.44cf328p-1, 0x1.7b7114f3fc4afp-28,
+-0x1.1c73b38p-1, -0x1.ae68c86c9774ap-29,
+-0x1.e2b5d38p-2, -0x1.bd8ec78362475p-36,
+-0x1.87de2a8p-2, 0x1.51569d2e59dbap-30,
+-0x1.294063p-2, 0x1.2a60fa574a369p-30,
+-0x1.8f8b84p-3, 0x1.cb2cfaa4da337p-30,
+-0x1.917a6cp-4, 0x1.eb25ea0f138c7p-31,
+},
+};
+#endif /* __OBSOLETE_MATH_DOUBLE */
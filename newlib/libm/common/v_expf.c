@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#include "v_mathf.h"
+
+#if V_MATHF
+
+/* Vector expf, using the same method and tables as expf.  */
+
+#define N (1 << EXP2F_TABLE_BITS)
+#define InvLn2N __exp2f_data.invln2_scaled
+#define T __exp2f_data.tab
+#define C __exp2f_data.poly_scaled
+#define SHIFT __exp2f_data.shift
+
+/* exp (XD) for two lanes which neither overflow nor underflow.  */
+static __always_inline v_f64x2_t
+v_expf_2 (v_f64x2_t xd)
+{
+  v_u64x2_t ki, i, t;
+  v_f64x2_t kd, z, r, r2, y, s;
+
+  /* x*N/Ln2 = k + r with r in [-1/2, 1/2] and int k.  */
+  z = InvLn2N * xd;
+  kd = z + SHIFT;
+  ki = (v_u64x2_t) kd;
+  kd -= SHIFT;
+  r = z - kd;
+
+  /* exp(x) = 2^(k/N) * 2^(r/N) ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  i = ki % N;
+  t = (v_u64x2_t) { T[i[0]], T[i[1]] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v_f64x2_t) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1;
+  y = z * r2 + y;
+  return y * s;
+}
+
+/* Lanes with |x| >= 88 or nan, which are left to expf.  */
+static __always_inline v_s32_t
+v_expf_special (v_f32_t x)
+{
+  v_u32_t abstop = ((v_u32_t) x >> 20) & 0x7ff;
+
+  return abstop >= (asuint (88.0f) >> 20);
+}
+
+/* An SSE2 register holds two doubles, so the halves of X are done
+   separately.  Special lanes are replaced with 0 to avoid spurious
+   exceptions.  */
+static __always_inline v_f32_t
+v_expf (v_f32_t x)
+{
+  v_s32_t special = v_expf_special (x);
+  v_f32_t xs = v_sel_f32 (special, (v_f32_t) { 0 }, x);
+  v_f32_t ret = v_join_f32 (v_expf_2 (v_lo_f64 (xs)), v_expf_2 (v_hi_f64 (xs)));
+
+  if (unlikely (v_any (special)))
+    return v_call_f32 (expf, x, ret, special);
+  return ret;
+}
+
+/* The AVX variants have room for all four lanes as doubles.  */
+static __always_inline v_f32_t
+v_expf_wide (v_f32_t x)
+{
+  v_s32_t special = v_expf_special (x);
+  v_u64_t ki, i, t;
+  v_f64_t xd, kd, z, r, r2, y, s;
+  v_f32_t ret;
+
+  xd = __builtin_convertvector (v_sel_f32 (special, (v_f32_t) { 0 }, x),
+                                v_f64_t);
+  z = InvLn2N * xd;
+  kd = z + SHIFT;
+  ki = (v_u64_t) kd;
+  kd -= SHIFT;
+  r = z - kd;
+
+  i = ki % N;
+  t = (v_u64_t) { T[i[0]], T[i[1]], T[i[2]], T[i[3]] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v_f64_t) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  y = C[2] * r + 1;
+  y = z * r2 + y;
+  y = y * s;
+
+  ret = __builtin_convertvector (y, v_f32_t);
+  if (unlikely (v_any (special)))
+    return v_call_f32 (expf, x, ret, special);
+  return ret;
+}
+
+V_MATHF_1_WIDE (expf, v_expf_wide)
+
+#endif /* V_MATHF */
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#include "v_mathf.h"
+
+#if V_MATHF
+
+/* Vector logf, using the same method and tables as logf.  */
+
+#define T __logf_data.tab
+#define A __logf_data.poly
+#define Ln2 __logf_data.ln2
+#define N (1 << LOGF_TABLE_BITS)
+#define OFF 0x3f330000
+
+static __always_inline v_f32_t
+v_logf (v_f32_t x)
+{
+  v_f64_t z, r, r2, y, y0, invc, logc;
+  v_u32_t ix, iz, tmp, i;
+  v_s32_t k, special;
+  v_f32_t ret;
+
+  /* x < 0x1p-126 or inf or nan, replace those lanes with 1 to avoid
+     spurious exceptions.  */
+  ix = (v_u32_t) x;
+  special = ix - 0x00800000 >= 0x7f800000 - 0x00800000;
+#if WANT_ROUNDING
+  /* Fix sign of zero with downward rounding when x==1.  */
+  special |= ix == 0x3f800000;
+#endif
+  ix = (v_u32_t) v_sel_f32 (special, (v_f32_t) { 1.0f, 1.0f, 1.0f, 1.0f }, x);
+
+  /* x = 2^k z; where z is in range [OFF,2*OFF] and exact.
+     The range is split into N subintervals.
+     The ith subinterval contains z and c is near its center.  */
+  tmp = ix - OFF;
+  i = (tmp >> (23 - LOGF_TABLE_BITS)) % N;
+  k = (v_s32_t) tmp >> 23; /* arithmetic shift */
+  iz = ix - (tmp & (uint32_t) 0x1ff << 23);
+  invc = (v_f64_t) { T[i[0]].invc, T[i[1]].invc, T[i[2]].invc, T[i[3]].invc };
+  logc = (v_f64_t) { T[i[0]].logc, T[i[1]].logc, T[i[2]].logc, T[i[3]].logc };
+  z = __builtin_convertvector ((v_f32_t) iz, v_f64_t);
+
+  /* log(x) = log1p(z/c-1) + log(c) + k*Ln2 */
+  r = z * invc - 1;
+  y0 = logc + __builtin_convertvector (k, v_f64_t) * Ln2;
+
+  /* Pipelined polynomial evaluation to approximate log1p(r).  */
+  r2 = r * r;
+  y = A[1] * r + A[2];
+  y = A[0] * r2 + y;
+  y = y * r2 + (y0 + r);
+
+  ret = __builtin_convertvector (y, v_f32_t);
+  if (unlikely (v_any (special)))
+    return v_call_f32 (logf, x, ret, special);
+  return ret;
+}
+
+V_MATHF_1 (logf)
+
+#endif /* V_MATHF */
@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Shared pieces of the vector versions of the float functions.
+
+   The kernels work on four floats at a time, widening them to doubles
+   as the scalar functions do and using the same tables and
+   polynomials.  Where the table lookups dominate, as for expf and
+   powf, the SSE2 kernels widen each half of the vector to two doubles
+   so that the arithmetic fits in one register.  Lanes which the
+   scalar function handles separately, such as those which overflow
+   or are NaN, are evaluated again with the scalar function so that
+   their results, exceptions and errno match.
+
+   The entry points follow the vector function ABI which GCC uses for
+   functions declared with __attribute__ ((simd ("notinbranch"))) in
+   math.h, _ZGV<isa>N<lanes><args>_<name>.  GCC may call any of the
+   x86_64 variants, b (SSE2, 4 lanes), c (AVX, 8 lanes), d (AVX2, 8
+   lanes) and e (AVX512F, 16 lanes), depending on the target, so all
+   of them are provided, each running the kernel on groups of four
+   lanes compiled for that instruction set.  The AArch64 AdvSIMD
+   variants, n, take 2 or 4 lanes and use the vector procedure call
+   standard.  */
+
+#ifndef _V_MATHF_H_
+#define _V_MATHF_H_
+
+#include <stdint.h>
+#include <math.h>
+#include "math_config.h"
+
+/* The entry points are built for every compiler which can build them.
+   math.h declares them only where they have been tested, for GCC 9 and
+   later with the simd attribute on x86_64, so some of these, including
+   all of the AArch64 ones, are there only for callers which declare
+   them themselves.  */
+#if !__OBSOLETE_MATH_FLOAT && (__GNUC_PREREQ (9, 0) || defined(__clang__)) && \
+    ((defined(__x86_64__) && defined(__SSE2__)) ||                      \
+     (defined(__aarch64__) && defined(__ARM_NEON)))
+# define V_MATHF 1
+#else
+# define V_MATHF 0
+#endif
+
+#if V_MATHF
+
+typedef float v_f32_t __attribute__ ((vector_size (16)));
+typedef uint32_t v_u32_t __attribute__ ((vector_size (16)));
+typedef int32_t v_s32_t __attribute__ ((vector_size (16)));
+typedef double v_f64_t __attribute__ ((vector_size (32)));
+typedef uint64_t v_u64_t __attribute__ ((vector_size (32)));
+typedef int64_t v_s64_t __attribute__ ((vector_size (32)));
+typedef double v_f64x2_t __attribute__ ((vector_size (16)));
+typedef uint64_t v_u64x2_t __attribute__ ((vector_size (16)));
+
+/* Return whether any lane of the mask M is set.  */
+static __always_inline int
+v_any (v_s32_t m)
+{
+  return (m[0] | m[1] | m[2] | m[3]) != 0;
+}
+
+/* Widen the low or high two lanes of X to double.  */
+static __always_inline v_f64x2_t
+v_lo_f64 (v_f32_t x)
+{
+  return (v_f64x2_t) { x[0], x[1] };
+}
+
+static __always_inline v_f64x2_t
+v_hi_f64 (v_f32_t x)
+{
+  return (v_f64x2_t) { x[2], x[3] };
+}
+
+/* Narrow the two lanes of LO and of HI to float and join them.  */
+static __always_inline v_f32_t
+v_join_f32 (v_f64x2_t lo, v_f64x2_t hi)
+{
+  return (v_f32_t) { (float) lo[0], (float) lo[1],
+                     (float) hi[0], (float) hi[1] };
+}
+
+/* Select A in lanes where M is set and B elsewhere.  */
+static __always_inline v_f32_t
+v_sel_f32 (v_s32_t m, v_f32_t a, v_f32_t b)
+{
+  return (v_f32_t) (((v_u32_t) a & (v_u32_t) m) | ((v_u32_t) b & ~(v_u32_t) m));
+}
+
+/* Replace the lanes of Y selected by SPECIAL with F applied to the
+   same lanes of X.  */
+static __always_inline v_f32_t
+v_call_f32 (float (*f) (float), v_f32_t x, v_f32_t y, v_s32_t special)
+{
+  int i;
+
+  for (i = 0; i < 4; i++)
+    if (special[i])
+      y[i] = f (x[i]);
+  return y;
+}
+
+static __always_inline v_f32_t
+v_call2_f32 (float (*f) (float, float), v_f32_t x1, v_f32_t x2, v_f32_t y,
+             v_s32_t special)
+{
+  int i;
+
+  for (i = 0; i < 4; i++)
+    if (special[i])
+      y[i] = f (x1[i], x2[i]);
+  return y;
+}
+
+/* Define the vector entry points for NAME in terms of the static
+   function v_NAME, which takes one (V_MATHF_1) or two (V_MATHF_2)
+   v_f32_t arguments.  V_MATHF_1_WIDE and V_MATHF_2_WIDE use WIDE
+   instead for the AVX and AVX512F variants.  */
+#if defined(__x86_64__)
+
+typedef float v_f32x8_t __attribute__ ((vector_size (32)));
+typedef float v_f32x16_t __attribute__ ((vector_size (64)));
+
+#define V_MATHF_WIDE_1(isa, n, isa_name, name, wide)                    \
+  __attribute__ ((__target__ (isa_name))) v_f32x##n##_t                 \
+  _ZGV##isa##N##n##v_##name (v_f32x##n##_t x);                          \
+  __attribute__ ((__target__ (isa_name))) v_f32x##n##_t                 \
+  _ZGV##isa##N##n##v_##name (v_f32x##n##_t x)                           \
+  {                                                                     \
+    union { v_f32x##n##_t v; v_f32_t q[n / 4]; } u = { .v = x };        \
+    int i;                                                              \
+    for (i = 0; i < n / 4; i++)                                         \
+      u.q[i] = wide (u.q[i]);                                           \
+    return u.v;                                                         \
+  }
+
+#define V_MATHF_WIDE_2(isa, n, isa_name, name, wide)                    \
+  __attribute__ ((__target__ (isa_name))) v_f32x##n##_t                 \
+  _ZGV##isa##N##n##vv_##name (v_f32x##n##_t x, v_f32x##n##_t y);        \
+  __attribute__ ((__target__ (isa_name))) v_f32x##n##_t                 \
+  _ZGV##isa##N##n##vv_##name (v_f32x##n##_t x, v_f32x##n##_t y)         \
+  {                                                                     \
+    union { v_f32x##n##_t v; v_f32_t q[n / 4]; } u, w;                  \
+    int i;                                                              \
+    u.v = x;                                                            \
+    w.v = y;                                                            \
+    for (i = 0; i < n / 4; i++)                                         \
+      u.q[i] = wide (u.q[i], w.q[i]);                                   \
+    return u.v;                                                         \
+  }
+
+#define V_MATHF_1_WIDE(name, wide)                                      \
+  v_f32_t _ZGVbN4v_##name (v_f32_t x);                                  \
+  v_f32_t _ZGVbN4v_##name (v_f32_t x) { return v_##name (x); }          \
+  V_MATHF_WIDE_1 (c, 8, "avx", name, wide)                              \
+  V_MATHF_WIDE_1 (d, 8, "avx2", name, wide)                             \
+  V_MATHF_WIDE_1 (e, 16, "avx512f", name, wide)
+
+#define V_MATHF_1(name) V_MATHF_1_WIDE (name, v_##name)
+
+#define V_MATHF_2_WIDE(name, wide)                                      \
+  v_f32_t _ZGVbN4vv_##name (v_f32_t x, v_f32_t y);                      \
+  v_f32_t _ZGVbN4vv_##name (v_f32_t x, v_f32_t y)                      \
+  {                                                                     \
+    return v_##name (x, y);                                             \
+  }                                                                     \
+  V_MATHF_WIDE_2 (c, 8, "avx", name, wide)                              \
+  V_MATHF_WIDE_2 (d, 8, "avx2", name, wide)                             \
+  V_MATHF_WIDE_2 (e, 16, "avx512f", name, wide)
+
+#define V_MATHF_2(name) V_MATHF_2_WIDE (name, v_##name)
+
+#elif defined(__aarch64__)
+
+typedef float v_f32x2_t __attribute__ ((vector_size (8)));
+
+#define V_VPCS __attribute__ ((aarch64_vector_pcs))
+
+/* The two lane variants copy their arguments into the upper lanes,
+   where they cannot add any work for the scalar function.  */
+#define V_MATHF_1(name)                                                 \
+  V_VPCS v_f32_t _ZGVnN4v_##name (v_f32_t x);                           \
+  V_VPCS v_f32_t _ZGVnN4v_##name (v_f32_t x) { return v_##name (x); }   \
+  V_VPCS v_f32x2_t _ZGVnN2v_##name (v_f32x2_t x);                       \
+  V_VPCS v_f32x2_t _ZGVnN2v_##name (v_f32x2_t x)                        \
+  {                                                                     \
+    v_f32_t r = v_##name ((v_f32_t) { x[0], x[1], x[0], x[1] });        \
+    return (v_f32x2_t) { r[0], r[1] };                                  \
+  }
+
+#define V_MATHF_2(name)                                                 \
+  V_VPCS v_f32_t _ZGVnN4vv_##name (v_f32_t x, v_f32_t y);               \
+  V_VPCS v_f32_t _ZGVnN4vv_##name (v_f32_t x, v_f32_t y)               \
+  {                                                                     \
+    return v_##name (x, y);                                             \
+  }                                                                     \
+  V_VPCS v_f32x2_t _ZGVnN2vv_##name (v_f32x2_t x, v_f32x2_t y);         \
+  V_VPCS v_f32x2_t _ZGVnN2vv_##name (v_f32x2_t x, v_f32x2_t y)          \
+  {                                                                     \
+    v_f32_t r = v_##name ((v_f32_t) { x[0], x[1], x[0], x[1] },         \
+                          (v_f32_t) { y[0], y[1], y[0], y[1] });        \
+    return (v_f32x2_t) { r[0], r[1] };                                  \
+  }
+
+/* AdvSIMD has no wider registers to use.  */
+#define V_MATHF_1_WIDE(name, wide) V_MATHF_1 (name)
+#define V_MATHF_2_WIDE(name, wide) V_MATHF_2 (name)
+
+#endif
+
+#endif /* V_MATHF */
+
+#endif /* _V_MATHF_H_ */
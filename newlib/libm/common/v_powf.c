@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fdlibm.h"
+#include "v_mathf.h"
+
+#if V_MATHF
+
+/* Vector powf, using the same method and tables as powf.  Only
+   positive normal x with y non-zero and finite and a result which
+   neither overflows nor underflows are computed here, other lanes are
+   passed to powf.  */
+
+#define LOG2_N (1 << POWF_LOG2_TABLE_BITS)
+#define LOG2_T __powf_log2_data.tab
+#define A __powf_log2_data.poly
+#define OFF 0x3f330000
+
+#define EXP2_N (1 << EXP2F_TABLE_BITS)
+#define EXP2_T __exp2f_data.tab
+#if TOINT_INTRINSICS
+/* The log2 result is scaled by EXP2_N, round it with the unscaled
+   shift.  */
+# define C __exp2f_data.poly_scaled
+# define SHIFT __exp2f_data.shift
+#else
+# define C __exp2f_data.poly
+# define SHIFT __exp2f_data.shift_scaled
+#endif
+
+/* exp2 (y log2 (x)) for lanes N and N + 1 as doubles, given
+   x = 2^k z and the log2 table index I.  OVER is set in lanes where
+   the result may overflow or underflow.  */
+static __always_inline v_f64x2_t
+v_powf_2 (v_u32_t iz, v_s32_t k, v_u32_t i, v_u32_t iy, int n,
+          v_u64x2_t *over)
+{
+  v_f64x2_t z, r, r2, r4, p, q, l, l0, invc, logc, ylogx, kd, s;
+  v_u64x2_t ki, j, t;
+
+  invc = (v_f64x2_t) { LOG2_T[i[n]].invc, LOG2_T[i[n + 1]].invc };
+  logc = (v_f64x2_t) { LOG2_T[i[n]].logc, LOG2_T[i[n + 1]].logc };
+  z = (v_f64x2_t) { asfloat (iz[n]), asfloat (iz[n + 1]) };
+
+  r = z * invc - 1;
+  l0 = logc + (v_f64x2_t) { k[n], k[n + 1] };
+
+  /* Pipelined polynomial evaluation to approximate log1p(r)/ln2.  */
+  r2 = r * r;
+  l = A[0] * r + A[1];
+  p = A[2] * r + A[3];
+  r4 = r2 * r2;
+  q = A[4] * r + l0;
+  q = p * r2 + q;
+  l = l * r4 + q;
+
+  ylogx = (v_f64x2_t) { asfloat (iy[n]), asfloat (iy[n + 1]) } * l;
+  /* |y*log(x)| >= 126 may overflow or underflow.  */
+  *over = (v_u64x2_t) (((v_u64x2_t) ylogx >> 47 & 0xffff)
+                       >= asuint64 (126.0 * POWF_SCALE) >> 47);
+
+  /* x = k/N + r with r in [-1/(2N), 1/(2N)] */
+  kd = ylogx + SHIFT;
+  ki = (v_u64x2_t) kd;
+  kd -= SHIFT;
+  r = ylogx - kd;
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  j = ki % EXP2_N;
+  t = (v_u64x2_t) { EXP2_T[j[0]], EXP2_T[j[1]] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v_f64x2_t) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  l = C[2] * r + 1;
+  l = z * r2 + l;
+  return l * s;
+}
+
+/* An SSE2 register holds two doubles, so after the integer steps the
+   halves are done separately.  */
+static __always_inline v_f32_t
+v_powf (v_f32_t x, v_f32_t y)
+{
+  v_u32_t ix, iy, iz, top, tmp, i;
+  v_u64x2_t over0, over1;
+  v_s32_t k, special;
+  v_f32_t ret;
+
+  /* x < 0x1p-126 or inf or nan or negative, or y is 0 or inf or nan.
+     Replace those lanes with 1 to avoid spurious exceptions.  */
+  ix = (v_u32_t) x;
+  iy = (v_u32_t) y;
+  special = (ix - 0x00800000 >= 0x7f800000 - 0x00800000)
+    | (2 * iy - 1 >= 2u * 0x7f800000 - 1);
+  ix = (v_u32_t) v_sel_f32 (special, (v_f32_t) { 1.0f, 1.0f, 1.0f, 1.0f }, x);
+  iy = (v_u32_t) v_sel_f32 (special, (v_f32_t) { 1.0f, 1.0f, 1.0f, 1.0f }, y);
+
+  /* log2(x) = log1p(z/c-1)/ln2 + log2(c) + k, with x = 2^k z where
+     z is in range [OFF,2*OFF] and exact.  */
+  tmp = ix - OFF;
+  i = (tmp >> (23 - POWF_LOG2_TABLE_BITS)) % LOG2_N;
+  top = tmp & 0xff800000;
+  iz = ix - top;
+  k = (v_s32_t) top >> (23 - POWF_SCALE_BITS); /* arithmetic shift */
+
+  ret = v_join_f32 (v_powf_2 (iz, k, i, iy, 0, &over0),
+                    v_powf_2 (iz, k, i, iy, 2, &over1));
+  special |= (v_s32_t) { over0[0], over0[1], over1[0], over1[1] };
+  if (unlikely (v_any (special)))
+    return v_call2_f32 (powf, x, y, ret, special);
+  return ret;
+}
+
+/* The AVX variants have room for all four lanes as doubles.  */
+static __always_inline v_f32_t
+v_powf_wide (v_f32_t x, v_f32_t y)
+{
+  v_f64_t z, r, r2, r4, p, q, l, l0, invc, logc, ylogx, kd, s;
+  v_u32_t ix, iy, iz, top, tmp, i;
+  v_u64_t ki, j, t;
+  v_s32_t k, special;
+  v_f32_t ret;
+
+  /* x < 0x1p-126 or inf or nan or negative, or y is 0 or inf or nan.
+     Replace those lanes with 1 to avoid spurious exceptions.  */
+  ix = (v_u32_t) x;
+  iy = (v_u32_t) y;
+  special = (ix - 0x00800000 >= 0x7f800000 - 0x00800000)
+    | (2 * iy - 1 >= 2u * 0x7f800000 - 1);
+  ix = (v_u32_t) v_sel_f32 (special, (v_f32_t) { 1.0f, 1.0f, 1.0f, 1.0f }, x);
+  iy = (v_u32_t) v_sel_f32 (special, (v_f32_t) { 1.0f, 1.0f, 1.0f, 1.0f }, y);
+
+  /* log2(x) = log1p(z/c-1)/ln2 + log2(c) + k, with x = 2^k z where
+     z is in range [OFF,2*OFF] and exact.  */
+  tmp = ix - OFF;
+  i = (tmp >> (23 - POWF_LOG2_TABLE_BITS)) % LOG2_N;
+  top = tmp & 0xff800000;
+  iz = ix - top;
+  k = (v_s32_t) top >> (23 - POWF_SCALE_BITS); /* arithmetic shift */
+  invc = (v_f64_t) { LOG2_T[i[0]].invc, LOG2_T[i[1]].invc,
+                     LOG2_T[i[2]].invc, LOG2_T[i[3]].invc };
+  logc = (v_f64_t) { LOG2_T[i[0]].logc, LOG2_T[i[1]].logc,
+                     LOG2_T[i[2]].logc, LOG2_T[i[3]].logc };
+  z = __builtin_convertvector ((v_f32_t) iz, v_f64_t);
+
+  r = z * invc - 1;
+  l0 = logc + __builtin_convertvector (k, v_f64_t);
+
+  /* Pipelined polynomial evaluation to approximate log1p(r)/ln2.  */
+  r2 = r * r;
+  l = A[0] * r + A[1];
+  p = A[2] * r + A[3];
+  r4 = r2 * r2;
+  q = A[4] * r + l0;
+  q = p * r2 + q;
+  l = l * r4 + q;
+
+  /* |y*log(x)| >= 126 may overflow or underflow.  */
+  ylogx = __builtin_convertvector ((v_f32_t) iy, v_f64_t) * l;
+  special |= __builtin_convertvector (((v_u64_t) ylogx >> 47 & 0xffff)
+                                      >= asuint64 (126.0 * POWF_SCALE) >> 47,
+                                      v_s32_t);
+
+  /* x = k/N + r with r in [-1/(2N), 1/(2N)] */
+  kd = ylogx + SHIFT;
+  ki = (v_u64_t) kd;
+  kd -= SHIFT;
+  r = ylogx - kd;
+
+  /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
+  j = ki % EXP2_N;
+  t = (v_u64_t) { EXP2_T[j[0]], EXP2_T[j[1]], EXP2_T[j[2]], EXP2_T[j[3]] };
+  t += ki << (52 - EXP2F_TABLE_BITS);
+  s = (v_f64_t) t;
+  z = C[0] * r + C[1];
+  r2 = r * r;
+  l = C[2] * r + 1;
+  l = z * r2 + l;
+  l = l * s;
+
+  ret = __builtin_convertvector (l, v_f32_t);
+  if (unlikely (v_any (special)))
+    return v_call2_f32 (powf, x, y, ret, special);
+  return ret;
+}
+
+V_MATHF_2_WIDE (powf, v_powf_wide)
+
+#endif /* V_MATHF */
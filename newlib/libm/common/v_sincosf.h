@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Vector kernel shared by the vector sinf and cosf, using the same
+   reduction and polynomials as sinf and cosf.  */
+
+#ifndef _V_SINCOSF_H_
+#define _V_SINCOSF_H_
+
+#include "v_mathf.h"
+#include "sincosf.h"
+
+/* Compute sin (X + Q * PI/2) for Q of 0 or 1.  Lanes with |X| >= 120,
+   which need the large range reduction, as well as infinities and
+   NaNs, are passed to F.  So are zero and subnormal X for sinf, which
+   returns them unchanged after raising underflow.  */
+static __always_inline v_f32_t
+v_sinf_inline (v_f32_t y, int q, float (*f) (float))
+{
+  const sincos_t *p = &__sincosf_table[0];
+  v_f64_t x, x2, x3, x4, x6, x7, s, s1, c, c1, c2, r;
+  v_s32_t n, special;
+  v_s64_t odd, neg;
+  v_u32_t abstop;
+  v_f32_t ret;
+
+  abstop = ((v_u32_t) y >> 20) & 0x7ff;
+  special = abstop >= (asuint (120.0f) >> 20);
+  if (q == 0)
+    special |= abstop < (asuint (0x1p-126f) >> 20);
+  x = __builtin_convertvector (v_sel_f32 (special, (v_f32_t) { 0 }, y),
+                               v_f64_t);
+
+  /* Reduce to [-PI/4, PI/4] with a single multiply-subtract.  */
+  r = x * p->hpi_inv;
+#if TOINT_INTRINSICS
+  {
+    v_f64_t kd = r + 0x1.8p52;
+    n = (v_s32_t) __builtin_convertvector ((v_u64_t) kd, v_u32_t);
+    x = x - (kd - 0x1.8p52) * p->hpi;
+  }
+#else
+  /* hpi_inv is prescaled by 2^24 so the quadrant ends up in bits 24..31.  */
+  n = (__builtin_convertvector (r, v_s32_t) + 0x800000) >> 24;
+  x = x - __builtin_convertvector (n, v_f64_t) * p->hpi;
+#endif
+  n += q;
+
+  /* Odd quadrants use the cosine polynomial, the result is negated in
+     quadrants 2 and 3.  */
+  odd = __builtin_convertvector ((n & 1) != 0, v_s64_t);
+  neg = __builtin_convertvector ((n & 2) != 0, v_s64_t);
+  x = (v_f64_t) ((v_u64_t) x ^ ((v_u64_t) neg & 0x8000000000000000ULL));
+
+  x2 = x * x;
+  x3 = x * x2;
+  s1 = p->s2 + x2 * p->s3;
+  x7 = x3 * x2;
+  s = x + x3 * p->s1;
+  s = s + x7 * s1;
+
+  x4 = x2 * x2;
+  c2 = p->c3 + x2 * p->c4;
+  c1 = p->c0 + x2 * p->c1;
+  x6 = x4 * x2;
+  c = c1 + x4 * p->c2;
+  c = c + x6 * c2;
+  c = (v_f64_t) ((v_u64_t) c ^ ((v_u64_t) neg & 0x8000000000000000ULL));
+
+  r = (v_f64_t) (((v_u64_t) c & (v_u64_t) odd)
+                 | ((v_u64_t) s & ~(v_u64_t) odd));
+  ret = __builtin_convertvector (r, v_f32_t);
+  if (unlikely (v_any (special)))
+    return v_call_f32 (f, y, ret, special);
+  return ret;
+}
+
+#endif /* _V_SINCOSF_H_ */
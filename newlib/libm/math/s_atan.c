@@ -66,6 +66,7 @@ PORTABILITY
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifdef _NEED_FLOAT64
 
@@ -162,3 +163,6 @@ atan64(__float64 x)
 _MATH_ALIAS_d_d(atan)
 
 #endif /* _NEED_FLOAT64 */
+#else
+#include "../common/atan.c"
+#endif /* __OBSOLETE_MATH_DOUBLE */
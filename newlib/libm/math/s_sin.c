@@ -81,6 +81,7 @@ QUICKREF
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 
 #ifdef _NEED_FLOAT64
 
@@ -128,3 +129,6 @@ __strong_reference(_NAME_64(sin), _NAME_64(_sin));
 _MATH_ALIAS_d_d(sin)
 
 #endif /* _NEED_FLOAT64 */
+#else
+#include "../common/sin.c"
+#endif /* __OBSOLETE_MATH_DOUBLE */
@@ -4,6 +4,7 @@
 
 #define _GNU_SOURCE
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_DOUBLE
 #include <errno.h>
 #include <math.h>
 
@@ -19,3 +20,6 @@ sincos64(__float64 x, __float64 *sinx, __float64 *cosx)
 _MATH_ALIAS_v_dDD(sincos)
 
 #endif /* _NEED_FLOAT64 */
+#else
+#include "../common/sincos.c"
+#endif /* __OBSOLETE_MATH_DOUBLE */
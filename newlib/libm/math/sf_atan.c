@@ -15,6 +15,7 @@
  */
 
 #include "fdlibm.h"
+#if __OBSOLETE_MATH_FLOAT
 
 static const float atanhi[] = {
     4.6364760399e-01, /* atan(0.5)hi 0x3eed6338 */
@@ -105,3 +106,7 @@ atanf(float x)
 }
 
 _MATH_ALIAS_f_f(atan)
+
+#else
+#include "../common/atanf.c"
+#endif /* __OBSOLETE_MATH_FLOAT */
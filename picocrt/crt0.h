@@ -54,6 +54,21 @@ extern char __tls_end[];
 #define __bss_size (__bss_end - __bss_start)
 #endif
 
+/*
+ * Tables of additional memory regions to initialize, for parts with
+ * more than one RAM bank. picolibc.ld collects these from the
+ * .copy_table, .unpack_table and .zero_table sections. Copy and
+ * unpack entries are {start, end, source}, zero entries are {start,
+ * end}. They're weak so that linker scripts without the tables still
+ * work.
+ */
+extern char *const __copy_table_start[] __weak;
+extern char *const __copy_table_end[] __weak;
+extern char *const __unpack_table_start[] __weak;
+extern char *const __unpack_table_end[] __weak;
+extern char *const __zero_table_start[] __weak;
+extern char *const __zero_table_end[] __weak;
+
 /* These two functions must be defined in the architecture-specific
  * code
  */
@@ -88,11 +103,46 @@ extern void __libc_init_array(void);
 #define CONSTRUCTORS 1
 #endif
 
+/*
+ * Expand an image with the runs of zeros squeezed out. A control
+ * byte c below 0x80 is followed by c + 1 literal bytes, otherwise it
+ * stands for c - 0x7f zero bytes.
+ */
+static __always_inline void
+__unpack(char *dst, char *end, const char *src)
+{
+	while (dst < end) {
+		unsigned char c = (unsigned char) *src++;
+		if (c < 0x80) {
+			memcpy(dst, src, c + 1);
+			src += c + 1;
+			dst += c + 1;
+		} else {
+			memset(dst, '\0', c - 0x7f);
+			dst += c - 0x7f;
+		}
+	}
+}
+
+static __always_inline void
+__init_regions(void)
+{
+	char *const *t;
+
+	for (t = __copy_table_start; t < __copy_table_end; t += 3)
+		memcpy(t[0], t[2], t[1] - t[0]);
+	for (t = __unpack_table_start; t < __unpack_table_end; t += 3)
+		__unpack(t[0], t[1], t[2]);
+	for (t = __zero_table_start; t < __zero_table_end; t += 2)
+		memset(t[0], '\0', t[1] - t[0]);
+}
+
 static __noreturn __always_inline void
 __start(void)
 {
 	memcpy(__data_start, __data_source, (uintptr_t) __data_size);
 	memset(__bss_start, '\0', (uintptr_t) __bss_size);
+	__init_regions();
 #ifdef POST_MEMORY_SETUP
         POST_MEMORY_SETUP();
 #endif
@@ -167,6 +167,13 @@ _trap(void)
                 "or	t0, t1, t0\n"
                 "csrw	mstatus, t0\n"
                 "csrwi	fcsr, 0");
+#endif
+#ifdef __riscv_vector
+	__asm__("csrr	t0, mstatus\n"
+                "li	t1, 512\n"     	// 1 << 9 = 512
+                "or	t0, t1, t0\n"
+                "csrw	mstatus, t0\n"
+                "csrwi	vcsr, 0");
 #endif
         __asm__("jal    _ctrap");
 }
@@ -200,6 +207,14 @@ _start(void)
                 "or	t0, t1, t0\n"
                 "csrw	mstatus, t0\n"
                 "csrwi	fcsr, 0");
+#endif
+        /* Enable the vector unit, which the string functions use */
+#ifdef __riscv_vector
+	__asm__("csrr	t0, mstatus\n"
+                "li	t1, 512\n"     	// 1 << 9 = 512
+                "or	t0, t1, t0\n"
+                "csrw	mstatus, t0\n"
+                "csrwi	vcsr, 0");
 #endif
 #ifdef CRT0_SEMIHOST
         __asm__("la     t0, _trap");
@@ -35,6 +35,52 @@
 
 #include <semihost.h>
 
+#ifdef __SEMIHOST_BUFIO
+
+#include <stdio-bufio.h>
+#include <unistd.h>
+
+/*
+ * Buffer output and send it with one SYS_WRITE per line instead of
+ * one SYS_WRITEC per character. read and write map fds 1 and 2 to
+ * the :tt handles; SYS_READC only returns one byte at a time, so
+ * there's no point in a larger input buffer.
+ */
+
+#ifndef __SEMIHOST_BUFSIZ
+#define __SEMIHOST_BUFSIZ 256
+#endif
+
+static char read_buf[1];
+static char write_buf[__SEMIHOST_BUFSIZ];
+static char error_buf[__SEMIHOST_BUFSIZ];
+
+static struct __file_bufio __stdin = FDEV_SETUP_BUFIO(0, read_buf, sizeof(read_buf),
+                                                      read, NULL, NULL, NULL,
+                                                      __SRD, 0);
+static struct __file_bufio __stdout = FDEV_SETUP_BUFIO(1, write_buf, sizeof(write_buf),
+                                                       NULL, write, NULL, NULL,
+                                                       __SWR, __BLBF);
+static struct __file_bufio __stderr = FDEV_SETUP_BUFIO(2, error_buf, sizeof(error_buf),
+                                                       NULL, write, NULL, NULL,
+                                                       __SWR, __BLBF);
+
+FILE *const stdin = &__stdin.xfile.cfile.file;
+FILE *const stdout = &__stdout.xfile.cfile.file;
+FILE *const stderr = &__stderr.xfile.cfile.file;
+
+/*
+ * Send any partial line on exit
+ */
+__attribute__((destructor (101)))
+static void semihost_exit(void)
+{
+    fflush(stdout);
+    fflush(stderr);
+}
+
+#else
+
 static FILE __stdio = FDEV_SETUP_STREAM(sys_semihost_putc, sys_semihost_getc, NULL, _FDEV_SETUP_RW);
 
 #ifdef __strong_reference
@@ -46,3 +92,5 @@ static FILE __stdio = FDEV_SETUP_STREAM(sys_semihost_putc, sys_semihost_getc, NU
 FILE *const stdin = &__stdio;
 STDIO_ALIAS(stdout);
 STDIO_ALIAS(stderr);
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdlib.h>
+
+#define WINDOW  64
+
+static void *window[WINDOW];
+
+/* Sizes drawn from a small, fixed pseudo-random sequence */
+static size_t
+bench_size(unsigned long i, size_t max)
+{
+    return ((i * 2654435761UL) >> 7) % max + 1;
+}
+
+static void
+bench_malloc_free_16(unsigned long n)
+{
+    while (n--) {
+        void *p = malloc(16);
+        bench_clobber(p);
+        free(p);
+    }
+}
+
+static void
+bench_malloc_free_1024(unsigned long n)
+{
+    while (n--) {
+        void *p = malloc(1024);
+        bench_clobber(p);
+        free(p);
+    }
+}
+
+static void
+bench_calloc_free_256(unsigned long n)
+{
+    while (n--) {
+        void *p = calloc(1, 256);
+        bench_clobber(p);
+        free(p);
+    }
+}
+
+/* Keep WINDOW blocks of mixed sizes live, replacing one per operation */
+static void
+bench_malloc_window(unsigned long n)
+{
+    unsigned long i;
+
+    for (i = 0; i < WINDOW; i++)
+        window[i] = malloc(bench_size(i, 512));
+    for (i = 0; i < n; i++) {
+        unsigned long slot = (i * 7) % WINDOW;
+        free(window[slot]);
+        window[slot] = malloc(bench_size(i + WINDOW, 512));
+        bench_clobber(window[slot]);
+    }
+    for (i = 0; i < WINDOW; i++) {
+        free(window[i]);
+        window[i] = NULL;
+    }
+}
+
+/* Grow a block from 16 to 4096 bytes one doubling at a time */
+static void
+bench_realloc_grow(unsigned long n)
+{
+    while (n--) {
+        void *p = NULL;
+        size_t size;
+
+        for (size = 16; size <= 4096; size <<= 1) {
+            void *q = realloc(p, size);
+            if (!q)
+                break;
+            p = q;
+        }
+        bench_clobber(p);
+        free(p);
+    }
+}
+
+int
+main(void)
+{
+    BENCH(malloc_free_16);
+    BENCH(malloc_free_1024);
+    BENCH(calloc_free_256);
+    BENCH(malloc_window);
+    BENCH(realloc_grow);
+    return 0;
+}
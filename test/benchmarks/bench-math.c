@@ -0,0 +1,155 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <math.h>
+
+#define NINPUT  256
+
+static double small[NINPUT];    /* [-pi, pi] */
+static double large[NINPUT];    /* [-1e6, 1e6] */
+static double unit[NINPUT];     /* [-1, 1] */
+static double positive[NINPUT]; /* (0, 1e6] */
+static double exps[NINPUT];     /* [-700, 700] */
+static float smallf[NINPUT];
+static float positivef[NINPUT];
+static float expsf[NINPUT];
+
+#define BENCH_D1(f, in)                                 \
+    static void                                         \
+    bench_ ## f ## _ ## in(unsigned long n)             \
+    {                                                   \
+        double sum = 0;                                 \
+        while (n--)                                     \
+            sum += f(in[n % NINPUT]);                   \
+        bench_sink_d = sum;                             \
+    }
+
+#define BENCH_F1(f, in)                                 \
+    static void                                         \
+    bench_ ## f ## _ ## in(unsigned long n)             \
+    {                                                   \
+        float sum = 0;                                  \
+        while (n--)                                     \
+            sum += f(in[n % NINPUT]);                   \
+        bench_sink_d = sum;                             \
+    }
+
+BENCH_D1(sin, small)
+BENCH_D1(sin, large)
+BENCH_D1(cos, small)
+BENCH_D1(cos, large)
+BENCH_D1(tan, small)
+BENCH_D1(atan, large)
+BENCH_D1(asin, unit)
+BENCH_D1(acos, unit)
+BENCH_D1(exp, exps)
+BENCH_D1(log, positive)
+BENCH_D1(sqrt, positive)
+BENCH_D1(cbrt, large)
+BENCH_F1(sinf, smallf)
+BENCH_F1(cosf, smallf)
+BENCH_F1(expf, expsf)
+BENCH_F1(logf, positivef)
+BENCH_F1(sqrtf, positivef)
+
+static void
+bench_atan2_small(unsigned long n)
+{
+    double sum = 0;
+    while (n--)
+        sum += atan2(small[n % NINPUT], small[(n + 1) % NINPUT]);
+    bench_sink_d = sum;
+}
+
+static void
+bench_pow_positive(unsigned long n)
+{
+    double sum = 0;
+    while (n--)
+        sum += pow(positive[n % NINPUT], unit[(n + 1) % NINPUT] * 4);
+    bench_sink_d = sum;
+}
+
+static void
+bench_powf_positivef(unsigned long n)
+{
+    float sum = 0;
+    while (n--)
+        sum += powf(positivef[n % NINPUT], smallf[(n + 1) % NINPUT]);
+    bench_sink_d = sum;
+}
+
+int
+main(void)
+{
+    int i;
+
+    for (i = 0; i < NINPUT; i++) {
+        /* Evenly spread values, permuted so consecutive inputs differ */
+        double t = (double) ((i * 97) % NINPUT) / (NINPUT - 1);
+
+        small[i] = (2 * t - 1) * 3.141592653589793;
+        large[i] = (2 * t - 1) * 1e6;
+        unit[i] = 2 * t - 1;
+        positive[i] = t * 1e6 + 1e-3;
+        exps[i] = (2 * t - 1) * 700;
+        smallf[i] = (float) small[i];
+        positivef[i] = (float) positive[i];
+        expsf[i] = (float) ((2 * t - 1) * 80);
+    }
+
+    BENCH(sin_small);
+    BENCH(sin_large);
+    BENCH(cos_small);
+    BENCH(cos_large);
+    BENCH(tan_small);
+    BENCH(atan_large);
+    BENCH(atan2_small);
+    BENCH(asin_unit);
+    BENCH(acos_unit);
+    BENCH(exp_exps);
+    BENCH(log_positive);
+    BENCH(pow_positive);
+    BENCH(sqrt_positive);
+    BENCH(cbrt_large);
+    BENCH(sinf_smallf);
+    BENCH(cosf_smallf);
+    BENCH(expf_expsf);
+    BENCH(logf_positivef);
+    BENCH(powf_positivef);
+    BENCH(sqrtf_positivef);
+    return 0;
+}
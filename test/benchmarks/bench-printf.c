@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+
+static const double doubles[] = {
+    0.0, 1.0, -1.5, 3.141592653589793, 2.718281828459045e10,
+    1e-300, 6.02214076e23, -123456.789, 0.1, 1.0/3.0,
+    9007199254740993.0, 5e-324, 1.7976931348623157e308, 42.0, 0.001, -7.25,
+};
+
+#define NDOUBLES        (sizeof(doubles) / sizeof(doubles[0]))
+
+static char buf[64];
+
+static void
+bench_snprintf_d(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%d", (int) (n * 2654435761UL));
+        bench_clobber(buf);
+    }
+}
+
+static void
+bench_snprintf_x_s(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%08lx %s", n, (n & 1) ? "odd" : "even");
+        bench_clobber(buf);
+    }
+}
+
+static void
+bench_snprintf_f(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%.3f", doubles[n % NDOUBLES] * 1e-290);
+        bench_clobber(buf);
+    }
+}
+
+static const char *const ints[] = {
+    "0", "42", "-17", "123456", "2147483647", "-2147483648", "0x7f", "00777",
+};
+
+#define NINTS   (sizeof(ints) / sizeof(ints[0]))
+
+static void
+bench_sscanf_d(unsigned long n)
+{
+    int i;
+    while (n--) {
+        sscanf(ints[n % NINTS], "%d", &i);
+        bench_sink_u = i;
+    }
+}
+
+static const char *const floats[] = {
+    "0", "1.5", "-3.25e2", "3.141592653589793", "6.02214076e23",
+    "1e-300", "0.1", "123456.789",
+};
+
+#define NFLOATS (sizeof(floats) / sizeof(floats[0]))
+
+static void
+bench_sscanf_lf(unsigned long n)
+{
+    double d;
+    while (n--) {
+        sscanf(floats[n % NFLOATS], "%lf", &d);
+        bench_sink_d = d;
+    }
+}
+
+static void
+bench_sscanf_s_d(unsigned long n)
+{
+    char word[16];
+    int i;
+    while (n--) {
+        sscanf("width 1024 height", "%15s %d", word, &i);
+        bench_sink_u = i + word[0];
+    }
+}
+
+int
+main(void)
+{
+    BENCH(snprintf_d);
+    BENCH(snprintf_x_s);
+    BENCH(snprintf_f);
+    BENCH(sscanf_d);
+    BENCH(sscanf_lf);
+    BENCH(sscanf_s_d);
+    return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NELEM   1000
+
+struct record {
+    uint32_t    key;
+    uint32_t    data[3];
+};
+
+static int ints[NELEM];
+static int ints_random[NELEM];
+static struct record records[NELEM];
+static struct record records_random[NELEM];
+
+static int
+int_cmp(const void *a, const void *b)
+{
+    int x = *(const int *) a;
+    int y = *(const int *) b;
+
+    return (x > y) - (x < y);
+}
+
+static int
+record_cmp(const void *a, const void *b)
+{
+    uint32_t x = ((const struct record *) a)->key;
+    uint32_t y = ((const struct record *) b)->key;
+
+    return (x > y) - (x < y);
+}
+
+static void
+bench_qsort_int_random(unsigned long n)
+{
+    while (n--) {
+        memcpy(ints, ints_random, sizeof(ints));
+        qsort(ints, NELEM, sizeof(ints[0]), int_cmp);
+        bench_clobber(ints);
+    }
+}
+
+static void
+bench_qsort_int_sorted(unsigned long n)
+{
+    int i;
+
+    while (n--) {
+        for (i = 0; i < NELEM; i++)
+            ints[i] = i;
+        qsort(ints, NELEM, sizeof(ints[0]), int_cmp);
+        bench_clobber(ints);
+    }
+}
+
+static void
+bench_qsort_int_reversed(unsigned long n)
+{
+    int i;
+
+    while (n--) {
+        for (i = 0; i < NELEM; i++)
+            ints[i] = NELEM - i;
+        qsort(ints, NELEM, sizeof(ints[0]), int_cmp);
+        bench_clobber(ints);
+    }
+}
+
+static void
+bench_qsort_int_few_keys(unsigned long n)
+{
+    int i;
+
+    while (n--) {
+        for (i = 0; i < NELEM; i++)
+            ints[i] = ints_random[i] & 7;
+        qsort(ints, NELEM, sizeof(ints[0]), int_cmp);
+        bench_clobber(ints);
+    }
+}
+
+static void
+bench_qsort_record_random(unsigned long n)
+{
+    while (n--) {
+        memcpy(records, records_random, sizeof(records));
+        qsort(records, NELEM, sizeof(records[0]), record_cmp);
+        bench_clobber(records);
+    }
+}
+
+int
+main(void)
+{
+    uint32_t seed = 1;
+    int i;
+
+    for (i = 0; i < NELEM; i++) {
+        seed = seed * 1103515245 + 12345;
+        ints_random[i] = (int) (seed >> 8);
+        records_random[i].key = seed;
+        records_random[i].data[0] = i;
+    }
+
+    printf("times are per sort of %d elements\n", NELEM);
+    BENCH(qsort_int_random);
+    BENCH(qsort_int_sorted);
+    BENCH(qsort_int_reversed);
+    BENCH(qsort_int_few_keys);
+    BENCH(qsort_record_random);
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <regex.h>
+#include <string.h>
+
+#define TEXT_LEN        1024
+
+static char text[TEXT_LEN + 1];
+
+static const struct {
+    const char *name;
+    const char *pattern;
+    int cflags;
+    size_t nmatch;
+} patterns[] = {
+    { "regexec_literal", "needle", REG_EXTENDED | REG_NOSUB, 0 },
+    { "regexec_literal_icase", "NEEDLE", REG_EXTENDED | REG_ICASE | REG_NOSUB, 0 },
+    { "regexec_class", "[0-9]+-[0-9]+", REG_EXTENDED | REG_NOSUB, 0 },
+    { "regexec_alternation", "(foo|bar|baz)qux", REG_EXTENDED | REG_NOSUB, 0 },
+    { "regexec_anchored", "^needle", REG_EXTENDED | REG_NEWLINE | REG_NOSUB, 0 },
+    { "regexec_submatch", "([a-z]+)@([a-z]+)\\.com", REG_EXTENDED, 3 },
+    { "regexec_basic", "ne*dle", REG_NOSUB, 0 },
+};
+
+#define N(a)    (sizeof(a) / sizeof(a[0]))
+
+static regex_t regex;
+static size_t nmatch;
+static regmatch_t match[3];
+
+static void
+bench_regexec(unsigned long n)
+{
+    while (n--)
+        bench_sink_u = regexec(&regex, text, nmatch, match, 0);
+}
+
+static void
+bench_regcomp(unsigned long n)
+{
+    regex_t r;
+
+    while (n--) {
+        if (regcomp(&r, "([a-z]+)@([a-z]+)\\.(com|org|net)", REG_EXTENDED) == 0)
+            regfree(&r);
+    }
+}
+
+/*
+ * Build a text of lowercase words split into lines which ends with
+ * the targets of all of the patterns so that every search scans the
+ * whole string.
+ */
+static void
+bench_text(void)
+{
+    static const char *const tail = "\n1-2 fooqux a@b.com needle\n";
+    size_t tail_len = strlen(tail);
+    size_t i;
+
+    for (i = 0; i < TEXT_LEN - tail_len; i++) {
+        if (i % 64 == 63)
+            text[i] = '\n';
+        else if (i % 8 == 7)
+            text[i] = ' ';
+        else
+            text[i] = 'a' + (i * 7) % 26;
+    }
+    memcpy(text + i, tail, tail_len + 1);
+}
+
+int
+main(void)
+{
+    size_t p;
+
+    bench_text();
+    printf("regexec times are per search of %d bytes\n", TEXT_LEN);
+    for (p = 0; p < N(patterns); p++) {
+        if (regcomp(&regex, patterns[p].pattern, patterns[p].cflags) != 0) {
+            printf("%s: regcomp failed\n", patterns[p].name);
+            continue;
+        }
+        nmatch = patterns[p].nmatch;
+        bench_run(patterns[p].name, bench_regexec);
+        regfree(&regex);
+    }
+    BENCH(regcomp);
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <string.h>
+
+#define MAX_SIZE        4096
+#define MAX_ALIGN       16
+
+static const size_t sizes[] = { 16, 256, MAX_SIZE };
+static const size_t aligns[] = { 0, 3 };
+
+#define N(a)    (sizeof(a) / sizeof(a[0]))
+
+static char src_buf[MAX_SIZE + MAX_ALIGN + 1] __attribute__((aligned(MAX_ALIGN)));
+static char dst_buf[MAX_SIZE + MAX_ALIGN + 1] __attribute__((aligned(MAX_ALIGN)));
+
+/* Parameters for the current run */
+static size_t size;
+static char *src;
+static char *dst;
+
+static void
+bench_memcpy(unsigned long n)
+{
+    while (n--) {
+        memcpy(dst, src, size);
+        bench_clobber(dst);
+    }
+}
+
+static void
+bench_memmove(unsigned long n)
+{
+    /* Shift dst up by one byte so that source and destination overlap */
+    while (n--) {
+        memmove(dst + 1, dst, size);
+        bench_clobber(dst);
+    }
+}
+
+static void
+bench_memset(unsigned long n)
+{
+    while (n--) {
+        memset(dst, (int) n, size);
+        bench_clobber(dst);
+    }
+}
+
+static void
+bench_memcmp(unsigned long n)
+{
+    while (n--) {
+        bench_clobber(dst);
+        bench_sink_u = memcmp(dst, src, size);
+    }
+}
+
+static void
+bench_strlen(unsigned long n)
+{
+    while (n--) {
+        bench_clobber(src);
+        bench_sink_u = strlen(src);
+    }
+}
+
+static void
+bench_strchr(unsigned long n)
+{
+    while (n--) {
+        bench_clobber(src);
+        bench_sink_u = (unsigned long) (uintptr_t) strchr(src, '!');
+    }
+}
+
+static void
+bench_strcmp(unsigned long n)
+{
+    while (n--) {
+        bench_clobber(dst);
+        bench_sink_u = strcmp(dst, src);
+    }
+}
+
+/* Fill src with 'size' non-nul bytes ending in '!' and copy it to dst */
+static void
+bench_setup(void)
+{
+    size_t i;
+
+    for (i = 0; i < size - 1; i++)
+        src[i] = 'a' + i % 26;
+    src[size - 1] = '!';
+    src[size] = '\0';
+    memcpy(dst, src, size + 1);
+}
+
+static const struct {
+    const char *name;
+    void (*func)(unsigned long n);
+} benches[] = {
+    { "memcpy", bench_memcpy },
+    { "memmove", bench_memmove },
+    { "memset", bench_memset },
+    { "memcmp", bench_memcmp },
+    { "strlen", bench_strlen },
+    { "strchr", bench_strchr },
+    { "strcmp", bench_strcmp },
+};
+
+int
+main(void)
+{
+    size_t b, s, a;
+    char name[64];
+
+    for (b = 0; b < N(benches); b++) {
+        for (s = 0; s < N(sizes); s++) {
+            for (a = 0; a < N(aligns); a++) {
+                size = sizes[s];
+                src = src_buf + aligns[a];
+                dst = dst_buf + aligns[a] / 2;
+                bench_setup();
+                snprintf(name, sizeof(name), "%s_%zu_align_%zu",
+                         benches[b].name, size, aligns[a]);
+                bench_run(name, benches[b].func);
+            }
+        }
+    }
+    return 0;
+}
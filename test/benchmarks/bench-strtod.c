@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdlib.h>
+
+static const char *const short_decimals[] = {
+    "0", "1.5", "-3.25", "0.1", "42", "100.001", "-0.5", "7e3",
+};
+
+static const char *const long_decimals[] = {
+    "3.141592653589793",
+    "2.2250738585072014e-308",
+    "1.7976931348623157e308",
+    "4.9406564584124654e-324",
+    "6.02214076e23",
+    "9007199254740993",
+    "0.30000000000000004",
+    "123456789012345678901234567890",
+};
+
+static const char *const hex_floats[] = {
+    "0x1p0", "0x1.8p3", "-0x1.fffffffffffffp1023", "0x1p-1074",
+    "0x1.921fb54442d18p1", "0xa.bp-4", "0x0.1p0", "0x1.23456789abcdep-50",
+};
+
+#define N(a)    (sizeof(a) / sizeof(a[0]))
+
+static const double doubles[] = {
+    0.0, 1.0, -1.5, 3.141592653589793, 2.718281828459045e10,
+    1e-300, 6.02214076e23, -123456.789, 0.1, 1.0/3.0,
+    9007199254740993.0, 5e-324, 1.7976931348623157e308, 42.0, 0.001, -7.25,
+};
+
+static void
+bench_strtod_short(unsigned long n)
+{
+    while (n--)
+        bench_sink_d = strtod(short_decimals[n % N(short_decimals)], NULL);
+}
+
+static void
+bench_strtod_long(unsigned long n)
+{
+    while (n--)
+        bench_sink_d = strtod(long_decimals[n % N(long_decimals)], NULL);
+}
+
+static void
+bench_strtod_hex(unsigned long n)
+{
+    while (n--)
+        bench_sink_d = strtod(hex_floats[n % N(hex_floats)], NULL);
+}
+
+static void
+bench_strtof_long(unsigned long n)
+{
+    while (n--)
+        bench_sink_d = strtof(long_decimals[n % N(long_decimals)], NULL);
+}
+
+static char buf[64];
+
+static void
+bench_dtoa_shortest(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%g", doubles[n % N(doubles)]);
+        bench_clobber(buf);
+    }
+}
+
+static void
+bench_dtoa_17(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%.17g", doubles[n % N(doubles)]);
+        bench_clobber(buf);
+    }
+}
+
+static void
+bench_dtoa_e(unsigned long n)
+{
+    while (n--) {
+        snprintf(buf, sizeof(buf), "%.6e", doubles[n % N(doubles)]);
+        bench_clobber(buf);
+    }
+}
+
+int
+main(void)
+{
+    BENCH(strtod_short);
+    BENCH(strtod_long);
+    BENCH(strtod_hex);
+    BENCH(strtof_long);
+    BENCH(dtoa_shortest);
+    BENCH(dtoa_17);
+    BENCH(dtoa_e);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bench.h"
+#include <stdlib.h>
+
+/* Dates cover the years -10000 through 10000 */
+#define YEAR_MIN        -10000
+#define YEAR_MAX        10000
+#define SECS_PER_YEAR   31556952LL      /* mean Gregorian year */
+
+#define NDATES  256
+
+static time_t times[NDATES];
+static struct tm tms[NDATES];
+
+static void
+bench_gmtime_r(unsigned long n)
+{
+    struct tm tm;
+
+    while (n--) {
+        gmtime_r(&times[n % NDATES], &tm);
+        bench_clobber(&tm);
+    }
+}
+
+static void
+bench_localtime_r(unsigned long n)
+{
+    struct tm tm;
+
+    while (n--) {
+        localtime_r(&times[n % NDATES], &tm);
+        bench_clobber(&tm);
+    }
+}
+
+static void
+bench_mktime(unsigned long n)
+{
+    struct tm tm;
+
+    while (n--) {
+        tm = tms[n % NDATES];
+        bench_sink_u = (unsigned long) mktime(&tm);
+    }
+}
+
+static void
+bench_strftime(unsigned long n)
+{
+    char buf[64];
+
+    while (n--) {
+        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %a %b %j", &tms[n % NDATES]);
+        bench_clobber(buf);
+    }
+}
+
+int
+main(void)
+{
+    int i;
+
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    tzset();
+
+    for (i = 0; i < NDATES; i++) {
+        long long year = YEAR_MIN + (long long) ((i * 97) % NDATES) * (YEAR_MAX - YEAR_MIN) / (NDATES - 1);
+
+        times[i] = (time_t) ((year - 1970) * SECS_PER_YEAR + i * 86399LL);
+        gmtime_r(&times[i], &tms[i]);
+    }
+
+    BENCH(gmtime_r);
+    BENCH(localtime_r);
+    BENCH(mktime);
+    BENCH(strftime);
+    return 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Minimal benchmark harness shared by the programs in this
+ * directory. Each benchmark is a function which performs the measured
+ * operation 'n' times; bench_run keeps doubling 'n' until the run
+ * takes long enough to swamp the clock resolution and then reports
+ * the time per operation.
+ *
+ * Under semihosting, time comes from SYS_ELAPSED/SYS_TICKFREQ when
+ * the host supports them and from the centisecond SYS_CLOCK
+ * otherwise. Native builds use the monotonic clock.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/time.h>
+
+#ifdef __ARM_SEMIHOST
+#include <semihost.h>
+#endif
+
+#define BENCH_NS_PER_SEC        1000000000ULL
+
+/* Shortest run accepted, as a multiple of the clock resolution */
+#ifndef BENCH_MIN_TICKS
+#define BENCH_MIN_TICKS         100
+#endif
+
+/* Shortest run accepted, in ns, regardless of clock resolution */
+#ifndef BENCH_MIN_NS
+#define BENCH_MIN_NS            (BENCH_NS_PER_SEC / 10)
+#endif
+
+/* Keep the compiler from discarding the work being measured */
+#define bench_clobber(p)        __asm__ volatile("" : : "g"(p) : "memory")
+
+static volatile double bench_sink_d;
+static volatile unsigned long bench_sink_u;
+
+static uint64_t bench_resolution = 1;
+
+#ifdef __ARM_SEMIHOST
+
+static uintptr_t bench_tickfreq;
+
+static void
+bench_init(void)
+{
+    bench_tickfreq = sys_semihost_tickfreq();
+    if (bench_tickfreq == (uintptr_t) -1 || sys_semihost_elapsed() == (uint64_t) -1)
+        bench_tickfreq = 0;
+    if (bench_tickfreq)
+        bench_resolution = (BENCH_NS_PER_SEC + bench_tickfreq - 1) / bench_tickfreq;
+    else
+        bench_resolution = BENCH_NS_PER_SEC / 100;
+}
+
+static uint64_t
+bench_now(void)
+{
+    if (bench_tickfreq) {
+        uint64_t ticks = sys_semihost_elapsed();
+        return ticks / bench_tickfreq * BENCH_NS_PER_SEC +
+            ticks % bench_tickfreq * BENCH_NS_PER_SEC / bench_tickfreq;
+    }
+    return (uint64_t) sys_semihost_clock() * (BENCH_NS_PER_SEC / 100);
+}
+
+#elif defined(CLOCK_MONOTONIC)
+
+static void
+bench_init(void)
+{
+    struct timespec res;
+
+    if (clock_getres(CLOCK_MONOTONIC, &res) == 0)
+        bench_resolution = (uint64_t) res.tv_sec * BENCH_NS_PER_SEC + (uint64_t) res.tv_nsec;
+}
+
+static uint64_t
+bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * BENCH_NS_PER_SEC + (uint64_t) ts.tv_nsec;
+}
+
+#else
+
+static void
+bench_init(void)
+{
+    bench_resolution = 1000;
+}
+
+static uint64_t
+bench_now(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (uint64_t) tv.tv_sec * BENCH_NS_PER_SEC + (uint64_t) tv.tv_usec * 1000;
+}
+
+#endif
+
+static void
+bench_run(const char *name, void (*func)(unsigned long n))
+{
+    static bool been_here;
+    unsigned long n = 1;
+    uint64_t min_ns;
+    uint64_t ns;
+    uint64_t ps_per_op;
+
+    if (!been_here) {
+        bench_init();
+        been_here = true;
+    }
+    min_ns = bench_resolution * BENCH_MIN_TICKS;
+    if (min_ns < BENCH_MIN_NS)
+        min_ns = BENCH_MIN_NS;
+
+    for (;;) {
+        uint64_t start = bench_now();
+        func(n);
+        ns = bench_now() - start;
+        if (ns >= min_ns || n > ULONG_MAX / 16)
+            break;
+        /* Jump ahead when the run was far too short */
+        if (ns < min_ns / 16)
+            n *= 16;
+        else
+            n *= 2;
+    }
+
+    ps_per_op = ns * 1000 / n;
+    printf("%-36s %10lu.%03lu ns/op %12lu ops\n", name,
+           (unsigned long) (ps_per_op / 1000),
+           (unsigned long) (ps_per_op % 1000), n);
+}
+
+#define BENCH(f)        bench_run(#f, bench_ ## f)
+
+#endif /* _BENCH_H_ */
@@ -89,6 +89,53 @@ static struct three t[] = {
     i3(848405), i3(3434), i3(3434344), i3(3535), i3(93994), i3(2230404), i3(4334)
 };
 
+/*
+ * McIlroy's "A Killer Adversary for Quicksort": values are only
+ * assigned as the sort compares elements, always in the way which
+ * makes quicksort pick the worst pivots. The number of comparisons
+ * needed shows whether the sort has a worst case bound.
+ */
+#define ANTI_N  1024
+
+static int anti_val[ANTI_N];
+static int anti_ptr[ANTI_N];
+static int anti_solid, anti_candidate;
+static long anti_ncmp;
+
+#define ANTI_GAS        ANTI_N
+
+static int anti_cmp(const void *av, const void *bv)
+{
+    int a = *(const int *) av;
+    int b = *(const int *) bv;
+
+    anti_ncmp++;
+    if (anti_val[a] == ANTI_GAS && anti_val[b] == ANTI_GAS) {
+        if (a == anti_candidate)
+            anti_val[a] = anti_solid++;
+        else
+            anti_val[b] = anti_solid++;
+    }
+    if (anti_val[a] == ANTI_GAS)
+        anti_candidate = a;
+    else if (anti_val[b] == ANTI_GAS)
+        anti_candidate = b;
+    return anti_val[a] - anti_val[b];
+}
+
+struct sixteen {
+    uint64_t key;
+    uint64_t data;
+};
+
+static int xcmp(const void *av, const void *bv)
+{
+    const struct sixteen *a = av, *b = bv;
+    return (a->key > b->key) ? 1 : (a->key < b->key) ? -1 : 0;
+}
+
+static struct sixteen x[300];
+
 static int test_qsort(void)
 {
 	int i;
@@ -125,6 +172,37 @@ static int test_qsort(void)
 	}
 
 
+        for (i = 0; i < ANTI_N; i++) {
+            anti_ptr[i] = i;
+            anti_val[i] = ANTI_GAS;
+        }
+        qsort(anti_ptr, ANTI_N, sizeof(anti_ptr[0]), anti_cmp);
+        /* A quadratic sort would need about ANTI_N * ANTI_N / 4 */
+        if (anti_ncmp > 8L * ANTI_N * 10)
+            FAIL("adversarial sort");
+	for (i=0; i<ANTI_N-1; i++) {
+		if (anti_val[anti_ptr[i]] > anti_val[anti_ptr[i+1]]) {
+			FAIL("adversarial sort order");
+			break;
+		}
+	}
+
+        /* Sorted, reversed and constant keys, with 16 byte elements */
+        int pattern;
+        for (pattern = 0; pattern < 3; pattern++) {
+            for (i = 0; i < (int) (sizeof(x)/sizeof(x[0])); i++) {
+                x[i].key = pattern == 0 ? (uint64_t) i : pattern == 1 ? (uint64_t) -i : 7;
+                x[i].data = ~x[i].key;
+            }
+            qsort(x, sizeof(x)/sizeof(x[0]), sizeof(x[0]), xcmp);
+            for (i=0; i<(int)(sizeof(x)/sizeof(x[0])); i++) {
+                if ((i && xcmp(&x[i-1], &x[i]) > 0) || x[i].data != ~x[i].key) {
+                    FAIL("sixteen byte sort");
+                    break;
+                }
+            }
+        }
+
 	return err;
 }
 
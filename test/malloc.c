@@ -227,6 +227,23 @@ main(void)
             printf("realloc: %d bytes of memory not cleared\n", wrong);
             result = 1;
         }
+        wrong = 0;
+        char *czero = malloc(256);
+        if (czero) {
+            memset(czero, 0x5a, 256);
+            free(czero);
+        }
+        czero = calloc(1, 256);
+        if (czero) {
+            for (pow = 0; pow < 256; pow++)
+                if (czero[pow] != 0)
+                    wrong++;
+            free(czero);
+        }
+        if (wrong)  {
+            printf("calloc: %d bytes of memory not cleared\n", wrong);
+            result = 1;
+        }
 
 	/* make sure realloc doesn't read past the source */
 
@@ -243,7 +260,7 @@ main(void)
 			char *med = realloc(small, 1024);
 			if (med) {
 //                                printf("med %p\n", med);
-#ifdef __NANO_MALLOC
+#if defined(__NANO_MALLOC) && defined(__NANO_MALLOC_CLEAR_ALLOCATED)
 				int i;
 				for (i = 128; i < 1024; i++)
 					if (med[i] != 0) {
@@ -258,6 +275,51 @@ main(void)
 		}
 	}
 
+#ifdef __NANO_MALLOC
+	/* make sure realloc grows into a free neighbor */
+	char *grow = malloc(512);
+	char *next = malloc(512);
+	char *fence = malloc(512);
+	if (grow && next && fence) {
+		int adjacent = next == grow + malloc_usable_size(grow) + sizeof(size_t);
+		memset(grow, '3', 512);
+		free(next);
+		char *grown = realloc(grow, 1000);
+		if (grown) {
+			if (adjacent && grown != grow) {
+				printf("realloc didn't grow into free neighbor\n");
+				++result;
+			}
+			for (pow = 0; pow < 512; pow++)
+				if (grown[pow] != '3') {
+					printf("realloc lost contents at %d\n", pow);
+					++result;
+					break;
+				}
+			grow = grown;
+		}
+	} else {
+		free(next);
+	}
+	free(grow);
+	free(fence);
+
+	struct malloc_instrument mi;
+	if (malloc_instrument(&mi) != 0 ||
+	    mi.largest_free > mi.free_bytes ||
+	    (mi.free_chunks == 0) != (mi.free_bytes == 0) ||
+	    mi.fragmentation > 1000) {
+		printf("malloc_instrument: inconsistent free list statistics\n");
+		++result;
+	}
+#ifdef __NANO_MALLOC_INSTRUMENT
+	if (mi.alloc_calls == 0 || mi.free_calls == 0) {
+		printf("malloc_instrument: calls not counted\n");
+		++result;
+	}
+#endif
+#endif
+
 	malloc_stats();
 
 	return result;
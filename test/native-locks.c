@@ -35,6 +35,7 @@
 
 #define _DEFAULT_SOURCE
 #include <pthread.h>
+#include <errno.h>
 #include <stdatomic.h>
 #include <stdbool.h>
 
@@ -149,22 +150,36 @@ void __retarget_lock_release_recursive(_LOCK_T lock)
         pthread_mutex_unlock(&lock->mut);
 }
 
-static pthread_t thread;
+#define MAX_THREADS 8
 
+static pthread_t threads[MAX_THREADS];
+static int num_threads;
+
+/* Start a thread, which is joined by the matching stop_thread call */
 int
 start_thread(void *(*func)(void *), void *arg);
 
 int
 start_thread(void *(*func)(void *), void *arg)
 {
-        return pthread_create(&thread, NULL, func, arg);
+        int ret;
+
+        if (num_threads == MAX_THREADS)
+                return EAGAIN;
+        ret = pthread_create(&threads[num_threads], NULL, func, arg);
+        if (ret == 0)
+                num_threads++;
+        return ret;
 }
 
+/* Join the most recently started thread */
 int
 stop_thread(void);
 
 int
 stop_thread(void)
 {
-        return pthread_join(thread, NULL);
+        if (num_threads == 0)
+                return EINVAL;
+        return pthread_join(threads[--num_threads], NULL);
 }
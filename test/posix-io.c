@@ -110,6 +110,62 @@ main(void)
         if (test_cmp(f, test_string))
                 return 1;
 
+	if (fclose(f) != 0) {
+		printf("fclose failed\n");
+		return 1;
+	}
+
+        /* Buffered data followed by a write larger than the buffer */
+        size_t big_len = BUFSIZ * 3 + 7;
+        char *big = malloc(big_len);
+        if (!big) {
+                printf("malloc failed\n");
+                return 1;
+        }
+        size_t i;
+        for (i = 0; i < big_len; i++)
+                big[i] = 'a' + i % 26;
+
+	f = fopen(file_name, "w+");
+	if (!f) {
+		printf("failed to open \"%s\" for writing\n", file_name);
+		return 1;
+	}
+        if ((size_t) fprintf(f, "%s", test_string) != strlen(test_string) ||
+            fwrite(big, 1, big_len, f) != big_len ||
+            (size_t) fprintf(f, "%s", test_string) != strlen(test_string)) {
+                printf("failed to write large block\n");
+                return 1;
+        }
+        if (fflush(NULL) != 0) {
+                printf("fflush(NULL) failed\n");
+                return 1;
+        }
+        if (fseek(f, 0, SEEK_SET)) {
+                printf("failed to seek to start\n");
+                return 1;
+        }
+        for (i = 0; i < strlen(test_string) * 2 + big_len; i++) {
+                int c = getc(f);
+                int want;
+                if (i < strlen(test_string))
+                        want = test_string[i];
+                else if (i < strlen(test_string) + big_len)
+                        want = big[i - strlen(test_string)];
+                else
+                        want = test_string[i - strlen(test_string) - big_len];
+                if (c != want) {
+                        printf("large block byte %zu: read %d expected %d\n", i, c, want);
+                        return 1;
+                }
+        }
+        if (getc(f) != EOF) {
+                printf("large block: extra data\n");
+                return 1;
+        }
+        free(big);
+        fclose(f);
+
 	printf("success\n");
         exit(0);
 }
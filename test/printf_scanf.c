@@ -370,6 +370,19 @@ main(void)
 		}
 	}
 
+	/*
+	 * test snprintf and vsnprintf with no buffer at all, which
+	 * only compute the length of the output
+	 */
+	for (y = 0; y < 2; y++) {
+		const char *name = (y == 0 ? "snprintf" : "vsnprintf");
+		int i = (y == 0 ? snprintf : check_vsnprintf) (NULL, 0, "hello %s %d%s|", "world", 42, "ab");
+		if (i != 17) {
+			printf("%s(NULL, 0, ...) return %d instead of %d\n", name, i, 17);
+			errors++;
+		}
+	}
+
 #define FMT(prefix,conv) "%" prefix conv
 
 #define VERIFY_BOTH(prefix, oconv, iconv) do {                          \
@@ -37,12 +37,15 @@
 #include <sys/types.h>
 #include <regex.h>
 #include <stdbool.h>
+#include <string.h>
 
 #define MAX_MATCH	10
 
 struct test {
 	const char	*pattern;
 	const char	*string;
+	int		cflags;
+	int		eflags;
 	int		ret;
 	int		nmatch;
 	regmatch_t matches[MAX_MATCH];
@@ -66,6 +69,43 @@ const struct test tests[] = {
 	{ .pattern = "x[a-c]*y", .string = "fooxaccabybar",
 	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 3, .rm_eo = 10 } }
 	},
+	{ .pattern = "^b", .string = "a\nb", .cflags = REG_NEWLINE,
+	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 2, .rm_eo = 3 } }
+	},
+	{ .pattern = "^b", .string = "a\nb",
+	  .ret = REG_NOMATCH,
+	},
+	{ .pattern = "a$", .string = "a\nb", .cflags = REG_NEWLINE,
+	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 0, .rm_eo = 1 } }
+	},
+	{ .pattern = "^x", .string = "xx", .eflags = REG_NOTBOL,
+	  .ret = REG_NOMATCH,
+	},
+	{ .pattern = "x$", .string = "xx", .eflags = REG_NOTEOL,
+	  .ret = REG_NOMATCH,
+	},
+#ifdef __PICOLIBC__
+	/* BSD word boundary syntax */
+	{ .pattern = "[[:<:]]bar[[:>:]]", .string = "foobar bars bar.",
+	  .ret = 0, .nmatch = 1, .matches = { { .rm_so = 12, .rm_eo = 15 } }
+	},
+#endif
+	{ .pattern = "(foo|ba[rz])+qux", .string = "foobaqux barbazquxx", .cflags = REG_NOSUB,
+	  .ret = 0,
+	},
+	{ .pattern = "(foo|ba[rz])+qux", .string = "foobaqux barbaquxx", .cflags = REG_NOSUB,
+	  .ret = REG_NOMATCH,
+	},
+	/* literal prefix with near misses before the match */
+	{ .pattern = "ab(c+)d", .string = "abxab aabccx abccd",
+	  .ret = 0, .nmatch = 2, .matches = {
+			{ .rm_so = 13, .rm_eo = 18 },
+			{ .rm_so = 15, .rm_eo = 17 },
+		},
+	},
+	{ .pattern = "ab\\(c*\\)d", .string = "abxab aabccx abcc",
+	  .ret = REG_NOMATCH,
+	},
 };
 
 #define NTEST (sizeof(tests)/sizeof(tests[0]))
@@ -82,13 +122,13 @@ main(void)
 	int	run = 0;
 
 	for (t = 0; t < NTEST; t++) {
-		ret = regcomp(&regex, tests[t].pattern, REG_EXTENDED);
+		ret = regcomp(&regex, tests[t].pattern, REG_EXTENDED | tests[t].cflags);
 		if (ret != 0) {
 			printf("expression \"%s\" failed to compile: %d\n", tests[t].pattern, ret);
 			errors++;
 			continue;
 		}
-		ret = regexec(&regex, tests[t].string, MAX_MATCH, matches, 0);
+		ret = regexec(&regex, tests[t].string, MAX_MATCH, matches, tests[t].eflags);
 		regfree(&regex);
 		if (ret != tests[t].ret) {
 			printf("match \"%s\" with \"%s\" bad result got %d != expect %d\n",
@@ -96,7 +136,7 @@ main(void)
 			errors++;
 			continue;
 		}
-		if (ret == 0) {
+		if (ret == 0 && !(tests[t].cflags & REG_NOSUB)) {
 			for (m = 0; m < MAX_MATCH; m++) {
 				if (m < tests[t].nmatch) {
 					if (matches[m].rm_so != tests[t].matches[m].rm_so ||
@@ -120,6 +160,43 @@ main(void)
 		}
 		++run;
 	}
+
+	/*
+	 * Search a long string with a pattern needing far more DFA
+	 * states than fit in the cache
+	 */
+	static char long_string[4096];
+	unsigned long seed = 1;
+	size_t len = sizeof(long_string) - 12;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		seed = seed * 1103515245 + 12345;
+		long_string[i] = (seed >> 16) & 1 ? 'a' : 'b';
+	}
+	strcpy(long_string + len, "abbbbbbbbbc");
+	ret = regcomp(&regex, "a[ab]{9}c", REG_EXTENDED);
+	if (ret != 0) {
+		printf("long expression failed to compile: %d\n", ret);
+		errors++;
+	} else {
+		ret = regexec(&regex, long_string, 1, matches, 0);
+		if (ret != 0 || matches[0].rm_so != (regoff_t) len ||
+		    matches[0].rm_eo != (regoff_t) len + 11) {
+			printf("long match got %d (%td,%td) expect 0 (%td,%td)\n",
+			       ret, matches[0].rm_so, matches[0].rm_eo,
+			       (regoff_t) len, (regoff_t) len + 11);
+			errors++;
+		}
+		long_string[len + 10] = 'b';
+		ret = regexec(&regex, long_string, 0, NULL, 0);
+		if (ret != REG_NOMATCH) {
+			printf("long non-match got %d\n", ret);
+			errors++;
+		}
+		regfree(&regex);
+		run += 2;
+	}
 	printf("regex: %d tests %d errors\n", run, errors);
 	return errors;
 }
@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <iconv.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__PICOLIBC__) && !defined(__MB_CAPABLE)
+
+int main(void)
+{
+    printf("iconv requires multi-byte support\n");
+    return 77;
+}
+
+#else
+
+#define S(s)    s, sizeof(s) - 1
+
+/*
+ * Conversions mixing runs of ASCII with other characters so that
+ * both the bulk copies and the per-character paths get used.
+ */
+static const struct {
+    const char  *from;
+    const char  *to;
+    const char  *in;
+    size_t      in_len;
+    const char  *out;
+    size_t      out_len;
+    size_t      err;            /* offset of invalid input, or 0 */
+} test[] = {
+    { "UTF-8", "UTF-8",
+      S("plain ascii text, long enough to fill several words \xc3\xa9\xe2\x82\xac\xf0\x9f\x9a\x80 end"),
+      S("plain ascii text, long enough to fill several words \xc3\xa9\xe2\x82\xac\xf0\x9f\x9a\x80 end"), 0 },
+    { "ASCII", "UTF-8", S("seven bit text\x80"), S("seven bit text"), 14 },
+#if !defined(__PICOLIBC__) || defined(__MB_EXTENDED_CHARSETS_UCS)
+    { "UTF-8", "UCS-4LE", S("abcdefghij\xc3\xa9\xe2\x82\xac\xf0\x9f\x9a\x80"),
+      S("a\0\0\0b\0\0\0c\0\0\0d\0\0\0e\0\0\0f\0\0\0g\0\0\0h\0\0\0i\0\0\0j\0\0\0"
+        "\xe9\0\0\0\xac\x20\0\0\x80\xf6\x01\0"), 0 },
+    { "UTF-8", "UCS-2BE", S("wide \xe2\x82\xac"),
+      S("\0w\0i\0d\0e\0 \x20\xac"), 0 },
+    { "UCS-2BE", "UTF-8", S("\0w\0i\0d\0e\0 \x20\xac\0!"),
+      S("wide \xe2\x82\xac!"), 0 },
+    { "UCS-4LE", "UTF-8", S("o\0\0\0k\0\0\0\x80\xf6\x01\0"),
+      S("ok\xf0\x9f\x9a\x80"), 0 },
+#ifdef __PICOLIBC__
+    /* glibc reports values beyond Unicode at a different offset */
+    { "UCS-4LE", "UCS-4BE", S("o\0\0\0k\0\0\0\0\0\x11\0"), S("\0\0\0o\0\0\0k"), 8 },
+#endif
+#endif
+#if !defined(__PICOLIBC__) || defined(__MB_EXTENDED_CHARSETS_ISO)
+    { "ISO-8859-1", "UTF-8", S("caf\xe9 cr\xe8me br\xfbl\xe9\x65"),
+      S("caf\xc3\xa9 cr\xc3\xa8me br\xc3\xbbl\xc3\xa9\x65"), 0 },
+    { "UTF-8", "ISO-8859-1", S("caf\xc3\xa9 cr\xc3\xa8me br\xc3\xbbl\xc3\xa9\x65"),
+      S("caf\xe9 cr\xe8me br\xfbl\xe9\x65"), 0 },
+    { "UTF-8", "ISO-8859-1", S("price 10\xe2\x82\xac"), S("price 10"), 8 },
+    { "ISO-8859-15", "UTF-8", S("price 10\xa4"), S("price 10\xe2\x82\xac"), 0 },
+    { "UTF-8", "ISO-8859-15", S("price 10\xe2\x82\xac"), S("price 10\xa4"), 0 },
+#endif
+#if !defined(__PICOLIBC__) || defined(__MB_EXTENDED_CHARSETS_WINDOWS)
+    { "CP1252", "UTF-8", S("\x80 and \x93quoted\x94"),
+      S("\xe2\x82\xac and \xe2\x80\x9cquoted\xe2\x80\x9d"), 0 },
+#endif
+};
+
+#define NTEST (sizeof(test)/sizeof(test[0]))
+
+static int
+check(unsigned i, size_t step)
+{
+    iconv_t     ic;
+    char        out[256];
+    char        *in_p = (char *) test[i].in;
+    char        *out_p = out;
+    size_t      in_len = test[i].in_len;
+    size_t      out_len;
+    size_t      ret = 0;
+    size_t      produced;
+    size_t      consumed;
+    int         status = 0;
+
+    ic = iconv_open(test[i].to, test[i].from);
+    if (ic == (iconv_t) -1) {
+        printf("iconv_open(\"%s\", \"%s\") failed\n", test[i].to, test[i].from);
+        return 1;
+    }
+
+    /* Feed the output space in steps, then flush anything held back */
+    do {
+        out_len = step;
+        if (out_len > sizeof(out) - (size_t) (out_p - out))
+            out_len = sizeof(out) - (size_t) (out_p - out);
+        produced = out_len;
+        consumed = in_len;
+        errno = 0;
+        ret = iconv(ic, &in_p, &in_len, &out_p, &out_len);
+        produced -= out_len;
+        consumed -= in_len;
+        /* Running out of output space may or may not be an error */
+        if (ret == (size_t) -1 && errno == E2BIG)
+            ret = 0;
+    } while (ret != (size_t) -1 && out_p != out + sizeof(out) &&
+             (produced != 0 || (in_len != 0 && consumed != 0)));
+
+    if (test[i].err) {
+        if (ret != (size_t) -1 || errno != EILSEQ) {
+            printf("test %u step %zu: expected EILSEQ\n", i, step);
+            status = 1;
+        } else if ((size_t) (in_p - test[i].in) != test[i].err) {
+            printf("test %u step %zu: error at %zu expected %zu\n",
+                   i, step, (size_t) (in_p - test[i].in), test[i].err);
+            status = 1;
+        }
+    } else if (ret == (size_t) -1) {
+        printf("test %u step %zu: failed at %zu\n", i, step, (size_t) (in_p - test[i].in));
+        status = 1;
+    }
+    if ((size_t) (out_p - out) != test[i].out_len ||
+        memcmp(out, test[i].out, test[i].out_len) != 0) {
+        printf("test %u step %zu: wrong output (%zu bytes, expected %zu)\n",
+               i, step, (size_t) (out_p - out), test[i].out_len);
+        status = 1;
+    }
+    iconv_close(ic);
+    return status;
+}
+
+int main(void)
+{
+    unsigned    i;
+    int         status = 0;
+
+    for (i = 0; i < NTEST; i++) {
+        status |= check(i, 256);
+#ifdef __PICOLIBC__
+        /* picolibc hands out partial characters as space allows */
+        status |= check(i, 1);
+        status |= check(i, 3);
+#endif
+    }
+    return status;
+}
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Check that crt0 walks the extra region tables collected by
+ * picolibc.ld. Each destination lives in .data with a non-zero
+ * initializer, so crt0 has to overwrite what it copied there from
+ * the .data image.
+ */
+
+#define FILL    0x55
+
+/* Zero-run packed image, in the format written by scripts/pack-zero-runs */
+static const unsigned char packed[] = {
+    0x05, 'r', 'e', 'g', 'i', 'o', 'n',         /* 6 literal bytes */
+    0x89,                                       /* 10 zeros */
+    0x03, 0x01, 0x02, 0x00, 0x03,               /* 4 literal bytes */
+    0xff, 0xc7,                                 /* 128 + 72 zeros */
+    0x02, 'e', 'n', 'd',                        /* 3 literal bytes */
+    0x82,                                       /* 3 zeros */
+};
+
+#define UNPACKED_SIZE   (6 + 10 + 4 + 200 + 3 + 3)
+
+static const char copy_source[] = "copied region";
+
+char unpacked[UNPACKED_SIZE] = { [0 ... UNPACKED_SIZE - 1] = FILL };
+char copied[sizeof(copy_source)] = { [0 ... sizeof(copy_source) - 1] = FILL };
+char zeroed[300] = { [0 ... 299] = FILL };
+
+/*
+ * The tables are walked as plain arrays of pointers, so keep the
+ * compiler from padding the entries out to a larger alignment
+ */
+#define ENTRY(name)     __attribute__((section(name), used, aligned(sizeof(char *))))
+
+static char *const unpack_entry[3] ENTRY(".unpack_table") = {
+    unpacked, unpacked + sizeof(unpacked), (char *) packed
+};
+
+static char *const copy_entry[3] ENTRY(".copy_table") = {
+    copied, copied + sizeof(copied), (char *) copy_source
+};
+
+static char *const zero_entry[2] ENTRY(".zero_table") = {
+    zeroed, zeroed + sizeof(zeroed)
+};
+
+extern char *const __copy_table_start[] __attribute__((weak));
+extern char *const __unpack_table_start[] __attribute__((weak));
+extern char *const __zero_table_start[] __attribute__((weak));
+
+/* Read through a volatile pointer so the initializers can't be folded in */
+static int
+check_bytes(const char *name, const char *region, size_t off, const char *expect, size_t len)
+{
+    const volatile char *p = region + off;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        char e = expect ? expect[i] : '\0';
+        if (p[i] != e) {
+            printf("%s[%zu] is 0x%02x expected 0x%02x\n", name, off + i,
+                   (unsigned char) p[i], (unsigned char) e);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    int ret = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    /* The x86 startup code doesn't walk the region tables */
+    printf("skipping region tests on x86\n");
+    return 77;
+#endif
+    if (!__copy_table_start || !__unpack_table_start || !__zero_table_start) {
+        printf("linker script has no region tables\n");
+        return 77;
+    }
+
+    ret += check_bytes("unpacked", unpacked, 0, "region", 6);
+    ret += check_bytes("unpacked", unpacked, 6, NULL, 10);
+    ret += check_bytes("unpacked", unpacked, 16, "\x01\x02\x00\x03", 4);
+    ret += check_bytes("unpacked", unpacked, 20, NULL, 200);
+    ret += check_bytes("unpacked", unpacked, 220, "end", 3);
+    ret += check_bytes("unpacked", unpacked, 223, NULL, 3);
+    ret += check_bytes("copied", copied, 0, copy_source, sizeof(copy_source));
+    ret += check_bytes("zeroed", zeroed, 0, NULL, sizeof(zeroed));
+    return ret != 0;
+}
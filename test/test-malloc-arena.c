@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define ALIGN   _Alignof(max_align_t)
+
+static int
+check(int ok, const char *what)
+{
+    if (!ok) {
+        printf("malloc_arena: %s failed\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    static char storage[1024];
+    struct malloc_arena arena;
+    char *a, *b, *c, *s;
+    size_t size;
+    FILE *f;
+    int ret = 0;
+    int i;
+
+    ret += check(malloc_arena_init(&arena, storage + 1, sizeof(storage) - 1) == 0, "init");
+
+    /* Allocations are aligned and don't overlap */
+    a = malloc_arena_alloc(&arena, 3);
+    b = malloc_arena_alloc(&arena, 17);
+    ret += check(a != NULL && b != NULL, "alloc");
+    ret += check(((uintptr_t) a % ALIGN) == 0 && ((uintptr_t) b % ALIGN) == 0, "alignment");
+    ret += check(b >= a + 3, "overlap");
+    ret += check(a >= storage && b + 17 <= storage + sizeof(storage), "bounds");
+
+    /* The last allocation is resized in place */
+    c = malloc_arena_realloc(&arena, b, 17, 200);
+    ret += check(c == b, "realloc in place");
+
+    /* Others are copied */
+    memset(a, 'x', 3);
+    c = malloc_arena_realloc(&arena, a, 3, 40);
+    ret += check(c != NULL && c != a && memcmp(c, "xxx", 3) == 0, "realloc copy");
+
+    /* Running out of space fails */
+    ret += check(malloc_arena_alloc(&arena, sizeof(storage)) == NULL, "exhaustion");
+
+    /* Reset releases everything */
+    malloc_arena_reset(&arena);
+    c = malloc_arena_alloc(&arena, 3);
+    ret += check(c == a, "reset");
+
+    /* Strings are printed into the arena */
+    i = malloc_arena_asprintf(&arena, &s, "%s %d", "hello", 42);
+    ret += check(i == 8 && s != NULL && strcmp(s, "hello 42") == 0, "asprintf");
+    ret += check(s >= storage && s + 9 <= storage + sizeof(storage), "asprintf storage");
+    b = malloc_arena_alloc(&arena, 1);
+    ret += check(b == s + ((9 + ALIGN - 1) & ~(ALIGN - 1)), "asprintf size");
+
+    /* So are memory streams */
+    f = malloc_arena_open_memstream(&arena, &s, &size);
+    ret += check(f != NULL, "open_memstream");
+    if (f) {
+        for (i = 0; i < 20; i++)
+            fprintf(f, "%d,", i);
+        fclose(f);
+        ret += check(size == 50 && strncmp(s, "0,1,2,", 6) == 0 && strcmp(s + 47, "19,") == 0,
+                     "open_memstream contents");
+        ret += check(s >= storage && s + 51 <= storage + sizeof(storage), "open_memstream storage");
+    }
+    malloc_arena_destroy(&arena);
+
+    /* Storage from the heap */
+    ret += check(malloc_arena_init(&arena, NULL, 4096) == 0, "heap init");
+    for (i = 0; i < 64; i++) {
+        a = malloc_arena_alloc(&arena, 48);
+        if (!a)
+            break;
+        memset(a, i, 48);
+    }
+    ret += check(i == 64, "heap alloc");
+    malloc_arena_destroy(&arena);
+
+    return ret;
+}
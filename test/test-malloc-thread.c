@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <malloc.h>
+
+/*
+ * Run malloc_stress style allocation patterns in several threads at
+ * once, passing some blocks between threads so that they are freed by
+ * a different thread than the one which allocated them. With the
+ * nano-malloc thread cache, each thread returns its cache to the heap
+ * as it exits, so the heap should be back where it started once all
+ * of the threads are done.
+ */
+
+#define NUM_THREADS	4
+#define NUM_MALLOC	64
+#define NUM_SHARED	16
+#define MAX_ALLOC	256
+#define LOOPS		20000
+
+struct block {
+    uint8_t     *data;
+    size_t      size;
+    uint8_t     fill;
+};
+
+static struct block *shared[NUM_SHARED];
+
+static _Atomic int errors;
+
+int
+start_thread(void *(*func)(void *), void *arg);
+
+int
+stop_thread(void);
+
+static uint32_t
+next_rand(uint32_t *seed)
+{
+    /* xorshift, as rand isn't required to be thread safe */
+    uint32_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *seed = x;
+}
+
+static struct block *
+new_block(uint32_t *seed)
+{
+    struct block *b = malloc(sizeof(struct block));
+
+    if (!b)
+        return NULL;
+    /* Mostly small sizes, which go through the thread cache */
+    if (next_rand(seed) & 7)
+        b->size = next_rand(seed) % 64;
+    else
+        b->size = next_rand(seed) % MAX_ALLOC;
+    b->fill = next_rand(seed);
+    b->data = malloc(b->size);
+    if (!b->data && b->size) {
+        free(b);
+        return NULL;
+    }
+    memset(b->data, b->fill, b->size);
+    return b;
+}
+
+static void
+free_block(struct block *b)
+{
+    size_t i;
+
+    if (!b)
+        return;
+    for (i = 0; i < b->size; i++) {
+        if (b->data[i] != b->fill) {
+            printf("block %p: wrong data at %zu\n", (void *) b->data, i);
+            errors++;
+            break;
+        }
+    }
+    free(b->data);
+    free(b);
+}
+
+static void *
+stress_func(void *arg)
+{
+    struct block *blocks[NUM_MALLOC] = { 0 };
+    uint32_t seed = (uint32_t) (uintptr_t) arg;
+    int loop, i;
+
+    for (loop = 0; loop < LOOPS; loop++) {
+        i = next_rand(&seed) % NUM_MALLOC;
+        if (next_rand(&seed) & 3) {
+            free_block(blocks[i]);
+            blocks[i] = new_block(&seed);
+        } else {
+            /* Swap a block with the shared pool, freeing blocks
+             * allocated by the other threads */
+            int s = next_rand(&seed) % NUM_SHARED;
+            blocks[i] = __atomic_exchange_n(&shared[s], blocks[i],
+                                            __ATOMIC_ACQ_REL);
+        }
+    }
+    for (i = 0; i < NUM_MALLOC; i++)
+        free_block(blocks[i]);
+#ifdef __NANO_MALLOC
+    __malloc_thread_exit();
+#endif
+    return NULL;
+}
+
+static void *
+idle_func(void *arg)
+{
+    return arg;
+}
+
+int
+main(void)
+{
+    int t, i;
+
+#ifdef __SINGLE_THREAD
+    printf("Single thread mode, test skipped\n");
+    return(77);
+#endif
+
+    /* Let the thread library make any allocations it keeps */
+    if (start_thread(idle_func, NULL) != 0) {
+        printf("start_thread failed\n");
+        return 1;
+    }
+    stop_thread();
+
+#ifdef __NANO_MALLOC
+    struct mallinfo start_info = mallinfo();
+#endif
+
+    for (t = 1; t < NUM_THREADS; t++) {
+        if (start_thread(stress_func, (void *) (uintptr_t) (t * 0x9e3779b1U)) != 0) {
+            printf("start_thread failed\n");
+            return 1;
+        }
+    }
+    stress_func((void *) (uintptr_t) 0x12345678U);
+    for (t = 1; t < NUM_THREADS; t++)
+        stop_thread();
+
+    for (i = 0; i < NUM_SHARED; i++)
+        free_block(shared[i]);
+
+#ifdef __NANO_MALLOC
+    struct mallinfo info = mallinfo();
+
+    if (info.uordblks != start_info.uordblks) {
+        printf("%zu bytes still in use after all threads exited\n",
+               info.uordblks - start_info.uordblks);
+        errors++;
+    }
+#endif
+
+    printf("malloc thread: %d errors\n", (int) errors);
+    return errors != 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int
+check(int ok, const char *what)
+{
+    if (!ok) {
+        printf("open_memstream: %s failed\n", what);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    char *buf = NULL;
+    size_t size = 0;
+    char line[64];
+    char big[1000];
+    FILE *f;
+    int ret = 0;
+    int i;
+
+    f = open_memstream(&buf, &size);
+    ret += check(f != NULL, "open");
+    if (!f)
+        return 1;
+
+    /* Output grows the buffer */
+    for (i = 0; i < 100; i++)
+        fprintf(f, "%d,", i);
+    fflush(f);
+    ret += check(size == 290 && strlen(buf) == size, "printf size");
+    ret += check(strncmp(buf, "0,1,2,", 6) == 0 && strcmp(buf + size - 3, "99,") == 0, "printf contents");
+
+    memset(big, 'x', sizeof(big));
+    ret += check(fwrite(big, 1, sizeof(big), f) == sizeof(big), "fwrite");
+    fflush(f);
+    ret += check(size == 1290 && buf[size] == '\0' && buf[size - 1] == 'x', "fwrite size");
+
+    /* Seeking back reports the position as the size */
+    ret += check(fseek(f, 4, SEEK_SET) == 0, "fseek");
+    fflush(f);
+    ret += check(size == 4, "seek size");
+
+    /* An unknown whence is rejected and leaves the position alone */
+    errno = 0;
+    ret += check(fseek(f, 8, 42) == -1 && errno == EINVAL, "fseek bad whence");
+    ret += check(ftell(f) == 4, "bad whence position");
+
+    /* Seeking past the end fills the gap with zeros */
+    ret += check(fseek(f, 1300, SEEK_SET) == 0, "fseek past end");
+    fputc('y', f);
+    fclose(f);
+    ret += check(size == 1301 && buf[1295] == '\0' && buf[1300] == 'y' && buf[1301] == '\0', "gap");
+    free(buf);
+
+    /* fmemopen reads and writes spans in place */
+    memset(big, 0, sizeof(big));
+    f = fmemopen(big, sizeof(big), "w+");
+    ret += check(f != NULL, "fmemopen");
+    if (!f)
+        return 1;
+    ret += check(fwrite("hello world\nsecond line\n", 1, 24, f) == 24, "fmemopen fwrite");
+    fflush(f);
+    ret += check(strcmp(big, "hello world\nsecond line\n") == 0, "fmemopen contents");
+    rewind(f);
+    ret += check(fread(line, 1, 6, f) == 6 && memcmp(line, "hello ", 6) == 0, "fmemopen fread");
+    ret += check(fgets(line, sizeof(line), f) && strcmp(line, "world\n") == 0, "fmemopen fgets");
+    ret += check(fread(line, 1, sizeof(line), f) == 12 && feof(f), "fmemopen fread eof");
+    fclose(f);
+
+    return ret;
+}
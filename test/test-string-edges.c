@@ -0,0 +1,257 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Check the string and memory functions around the places where
+ * vectorized versions change strategy: short tails, every relative
+ * alignment of source and destination, overlapping moves in both
+ * directions and strings which end right at the end of an aligned
+ * block, where a vector load of the next block would cross a page.
+ */
+
+#if __SIZEOF_POINTER__ <= 2
+#define PAGE    256
+#else
+#define PAGE    4096
+#endif
+
+#define MAX_LEN 160     /* longer than a few vector registers */
+#define MAX_OFF 16
+
+static char page[2 * PAGE] __attribute__((aligned(PAGE)));
+static char src[MAX_LEN + 2 * MAX_OFF + 1];
+static char dst[MAX_LEN + 2 * MAX_OFF + 1];
+
+static int errors;
+
+#define check(cond, ...) do {                   \
+        if (!(cond)) {                          \
+            printf(__VA_ARGS__);                \
+            printf("\n");                       \
+            if (++errors > 20)                  \
+                return;                         \
+        }                                       \
+    } while(0)
+
+static char
+pattern(size_t i)
+{
+    /* Never zero, and with the high bit set in some bytes */
+    return (char) (((i * 37) % 255) + 1);
+}
+
+static int
+sign(int v)
+{
+    return (v > 0) - (v < 0);
+}
+
+static void
+test_memcpy(void)
+{
+    size_t len, d, s, i;
+
+    for (i = 0; i < sizeof(src); i++)
+        src[i] = pattern(i);
+    for (len = 0; len <= MAX_LEN; len++)
+        for (d = 0; d < MAX_OFF; d++)
+            for (s = 0; s < MAX_OFF; s++) {
+                memset(dst, 0, sizeof(dst));
+                check(memcpy(dst + d, src + s, len) == dst + d,
+                      "memcpy return len %zu", len);
+                for (i = 0; i < sizeof(dst); i++) {
+                    char e = (i >= d && i < d + len) ? src[s + i - d] : 0;
+                    check(dst[i] == e, "memcpy(dst+%zu, src+%zu, %zu) byte %zu",
+                          d, s, len, i);
+                }
+            }
+}
+
+static void
+test_memmove(void)
+{
+    size_t len, d, s, i;
+
+    for (len = 0; len <= MAX_LEN; len++)
+        for (d = 0; d < 2 * MAX_OFF; d++)
+            for (s = 0; s < 2 * MAX_OFF; s++) {
+                for (i = 0; i < sizeof(dst); i++)
+                    dst[i] = src[i] = pattern(i);
+                /* src holds the original contents for comparison */
+                check(memmove(dst + d, dst + s, len) == dst + d,
+                      "memmove return len %zu", len);
+                for (i = 0; i < sizeof(dst); i++) {
+                    char e = (i >= d && i < d + len) ? src[s + i - d] : src[i];
+                    check(dst[i] == e, "memmove(dst+%zu, dst+%zu, %zu) byte %zu",
+                          d, s, len, i);
+                }
+            }
+}
+
+static void
+test_memset(void)
+{
+    size_t len, d, i;
+
+    for (len = 0; len <= MAX_LEN; len++)
+        for (d = 0; d < MAX_OFF; d++) {
+            memset(dst, 0, sizeof(dst));
+            check(memset(dst + d, 0xa5, len) == dst + d,
+                  "memset return len %zu", len);
+            for (i = 0; i < sizeof(dst); i++) {
+                char e = (i >= d && i < d + len) ? (char) 0xa5 : 0;
+                check(dst[i] == e, "memset(dst+%zu, 0xa5, %zu) byte %zu",
+                      d, len, i);
+            }
+        }
+
+    /* Up to the end of the block */
+    for (len = 0; len <= MAX_LEN; len++) {
+        memset(page, 0, sizeof(page));
+        memset(page + PAGE - len, 0x5a, len);
+        for (i = PAGE - MAX_LEN - 1; i < PAGE + 1; i++)
+            check(page[i] == (i >= PAGE - len && i < PAGE ? 0x5a : 0),
+                  "memset to block end len %zu byte %zu", len, i);
+    }
+}
+
+/* Fill the page buffer and put a string of 'len' bytes ending right
+ * at the end of the first block */
+static char *
+edge_string(size_t len)
+{
+    size_t i;
+    char *s = page + PAGE - 1 - len;
+
+    for (i = 0; i < sizeof(page); i++)
+        page[i] = pattern(i);
+    page[PAGE - 1] = '\0';
+    return s;
+}
+
+static void
+test_strlen(void)
+{
+    size_t len, s;
+
+    for (len = 0; len <= MAX_LEN; len++) {
+        check(strlen(edge_string(len)) == len, "strlen at block end len %zu", len);
+        for (s = 0; s < MAX_OFF; s++) {
+            memset(src, 'x', sizeof(src));
+            src[s + len] = '\0';
+            check(strlen(src + s) == len, "strlen(src+%zu) len %zu", s, len);
+        }
+    }
+}
+
+static int
+ref_strncmp(const char *a, const char *b, size_t n)
+{
+    for (; n; n--, a++, b++) {
+        if (*a != *b)
+            return (unsigned char) *a - (unsigned char) *b;
+        if (!*a)
+            break;
+    }
+    return 0;
+}
+
+static void
+test_strcmp(void)
+{
+    size_t len, s, d, diff, n;
+
+    for (len = 0; len <= MAX_LEN; len++) {
+        /* Equal strings, one ending at the end of the block */
+        char *e = edge_string(len);
+        memcpy(dst, e, len + 1);
+        check(strcmp(e, dst) == 0 && strcmp(dst, e) == 0,
+              "strcmp at block end len %zu", len);
+        check(strncmp(e, dst, len + 8) == 0, "strncmp at block end len %zu", len);
+
+        for (s = 0; s < MAX_OFF; s++)
+            for (d = 0; d < MAX_OFF; d += 3) {
+                char *a = src + s, *b = dst + d;
+                size_t i;
+
+                for (i = 0; i < len; i++)
+                    a[i] = b[i] = pattern(i);
+                a[len] = b[len] = '\0';
+                check(strcmp(a, b) == 0, "strcmp equal +%zu +%zu len %zu", s, d, len);
+
+                /* A difference at each position, either way round, with
+                 * and without the high bit */
+                for (diff = 0; diff < len; diff += 1 + diff / 8) {
+                    char save = b[diff];
+                    b[diff] = (char) (save ^ 0x80);
+                    check(sign(strcmp(a, b)) == sign(ref_strncmp(a, b, SIZE_MAX)),
+                          "strcmp +%zu +%zu len %zu diff %zu", s, d, len, diff);
+                    check(sign(strcmp(b, a)) == sign(ref_strncmp(b, a, SIZE_MAX)),
+                          "strcmp swapped +%zu +%zu len %zu diff %zu", s, d, len, diff);
+                    for (n = diff > 2 ? diff - 2 : 0; n <= diff + 2; n++)
+                        check(sign(strncmp(a, b, n)) == sign(ref_strncmp(a, b, n)),
+                              "strncmp +%zu +%zu len %zu diff %zu n %zu", s, d, len, diff, n);
+                    b[diff] = save;
+                }
+
+                /* One string a prefix of the other */
+                if (len) {
+                    b[len - 1] = '\0';
+                    check(strcmp(a, b) > 0 && strcmp(b, a) < 0,
+                          "strcmp prefix +%zu +%zu len %zu", s, d, len);
+                    check(strncmp(a, b, len - 1) == 0 && strncmp(a, b, len) > 0,
+                          "strncmp prefix +%zu +%zu len %zu", s, d, len);
+                }
+                check(strncmp(a, b, 0) == 0, "strncmp n 0");
+            }
+    }
+}
+
+int
+main(void)
+{
+    test_memcpy();
+    test_memmove();
+    test_memset();
+    test_strlen();
+    test_strcmp();
+    printf("string edges: %d errors\n", errors);
+    return errors != 0;
+}
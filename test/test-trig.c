@@ -0,0 +1,267 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <float.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Check sin, cos, tan and sincos against correctly rounded results
+ * for arguments which stress the range reduction: near multiples of
+ * PI/2, near the table and reduction boundaries and very large. The
+ * inverse functions are checked near their table boundaries, near
+ * the points where arguments are swapped and close to 1.
+ */
+
+#if DBL_MANT_DIG == 53
+
+struct trig_vec {
+    double      x, s, c, t;
+};
+
+static const struct trig_vec trig_vec[] = {
+    { .x = 0x1p-30, .s = 0x1p-30, .c = 0x1p+0, .t = 0x1p-30 },
+    { .x = 0x1.8p-5, .s = 0x1.7fdc01032fba9p-5, .c = 0x1.ff7006bfdf99fp-1, .t = 0x1.80481036e4452p-5 },
+    { .x = 0x1p-4, .s = 0x1.ffaaaeeed4edbp-5, .c = 0x1.ff0015549f4d3p-1, .t = 0x1.005577854df01p-4 },
+    { .x = 0x1.0000000000001p-4, .s = 0x1.ffaaaeeed4eddp-5, .c = 0x1.ff0015549f4d3p-1, .t = 0x1.005577854df02p-4 },
+    { .x = 0x1.921fb54442d18p-5, .s = 0x1.91f65f10dd814p-5, .c = 0x1.ff621e3796d7ep-1, .t = 0x1.927278a3b1162p-5 },
+    { .x = 0x1p-1, .s = 0x1.eaee8744b05fp-2, .c = 0x1.c1528065b7d5p-1, .t = 0x1.17b4f5bf3474ap-1 },
+    { .x = 0x1.921fb54442d18p-1, .s = 0x1.6a09e667f3bccp-1, .c = 0x1.6a09e667f3bcdp-1, .t = 0x1.fffffffffffffp-1 },
+    { .x = 0x1p+0, .s = 0x1.aed548f090ceep-1, .c = 0x1.14a280fb5068cp-1, .t = 0x1.8eb245cbee3a6p+0 },
+    { .x = 0x1p+1, .s = 0x1.d18f6ead1b446p-1, .c = -0x1.aa22657537205p-2, .t = -0x1.17af62e0950f8p+1 },
+    { .x = 0x1.2d97bffffffffp+1, .s = 0x1.6a09fce45a2d9p-1, .c = -0x1.6a09cfeb8be67p-1, .t = -0x1.00001fccca6e7p+0 },
+    { .x = 0x1.2d97cp+1, .s = 0x1.6a09fce45a2d6p-1, .c = -0x1.6a09cfeb8be6ap-1, .t = -0x1.00001fccca6e3p+0 },
+    { .x = 0x1.8p+1, .s = 0x1.210386db6d55bp-3, .c = -0x1.fae04be85e5d2p-1, .t = -0x1.23ef71254b86fp-3 },
+    { .x = 0x1.921fb54442d18p+0, .s = 0x1p+0, .c = 0x1.1a62633145c07p-54, .t = 0x1.d02967c31cdb5p+53 },
+    { .x = 0x1.921fb54442d18p+1, .s = 0x1.1a62633145c07p-53, .c = -0x1p+0, .t = -0x1.1a62633145c07p-53 },
+    { .x = 0x1.2d97c7f3321d2p+2, .s = -0x1p+0, .c = -0x1.a79394c9e8a0ap-53, .t = 0x1.3570efd768923p+52 },
+    { .x = 0x1.6p+4, .s = -0x1.220a29f6eb9f4p-7, .c = -0x1.fffadd8d4acdap-1, .t = 0x1.220d129b73ef8p-7 },
+    { .x = 0x1.63p+8, .s = -0x1.f9bd0307d1de3p-16, .c = -0x1.fffffffc18e4cp-1, .t = 0x1.f9bd030bacc16p-16 },
+    { .x = -0x1.957ea8dc859b9p+3, .s = -0x1.aead9ffd1a987p-4, .c = 0x1.fd2970c095241p-1, .t = -0x1.b11430c90fb11p-4 },
+    { .x = -0x1.2632a2c3ecd66p+2, .s = 0x1.fc95f92e80885p-1, .c = -0x1.d83bdcfaa169fp-4, .t = -0x1.13b4e1e68bd08p+3 },
+    { .x = 0x1.88dd9af3f19aap+2, .s = -0x1.273b0b720b865p-3, .c = 0x1.faa6f51eabee9p-1, .t = -0x1.2a58cc371de54p-3 },
+    { .x = 0x1.fffffffffffffp+15, .s = 0x1.62566735c3dddp-1, .c = -0x1.719453108776p-1, .t = -0x1.eae2708d13f77p-1 },
+    { .x = 0x1p+16, .s = 0x1.62566735b8513p-1, .c = -0x1.719453109288bp-1, .t = -0x1.eae2708cf5425p-1 },
+    { .x = 0x1.e848p+19, .s = -0x1.6664b2568d867p-2, .c = 0x1.df9df9906d32cp-1, .t = -0x1.7e9768ab734cp-2 },
+    { .x = 0x1.0f0cf064dd592p+73, .s = -0x1.b453ab76bf397p-1, .c = 0x1.0be2cef01c8f4p-1, .t = -0x1.a0f79c1b6b257p+0 },
+    { .x = 0x1.fffffffffffffp+1023, .s = 0x1.452fc98b34e97p-8, .c = -0x1.fffe62ecfab75p-1, .t = -0x1.4530cfe729484p-8 },
+    { .x = -0x1.cp+2, .s = -0x1.50608c26d0a08p-1, .c = 0x1.81ff79ed92017p-1, .t = -0x1.be2e6e13eea79p-1 },
+    { .x = -0x1.9p+6, .s = 0x1.03425b78c4db8p-1, .c = 0x1.b981dbf665fdfp-1, .t = 0x1.2ca74d62b5d38p-1 },
+    { .x = 0x1.5fdbbe9bba775p+5, .s = -0x1.ee2c2d963a10cp-50, .c = 0x1p+0, .t = -0x1.ee2c2d963a10cp-50 },
+};
+
+#define NTRIG   (sizeof(trig_vec)/sizeof(trig_vec[0]))
+
+struct atan_vec {
+    double      x, r;
+};
+
+static const struct atan_vec atan_vec[] = {
+    { .x = 0x1p-30, .r = 0x1p-30 },
+    { .x = 0x1.fffffffffffffp-7, .r = 0x1.fff555bbb729ap-7 },
+    { .x = 0x1p-5, .r = 0x1.ffd55bba97625p-6 },
+    { .x = 0x1.0000000000001p-5, .r = 0x1.ffd55bba97627p-6 },
+    { .x = 0x1.fffffffffffffp-5, .r = 0x1.ff55bb72cfde9p-5 },
+    { .x = 0x1p-4, .r = 0x1.ff55bb72cfdeap-5 },
+    { .x = 0x1.04p-4, .r = 0x1.03a6d1c06693dp-4 },
+    { .x = 0x1.8p-2, .r = 0x1.6f61941e4def1p-2 },
+    { .x = 0x1p-1, .r = 0x1.dac670561bb4fp-2 },
+    { .x = 0x1.fffffffffffffp-1, .r = 0x1.921fb54442d18p-1 },
+    { .x = 0x1p+0, .r = 0x1.921fb54442d18p-1 },
+    { .x = 0x1.0000000000001p+0, .r = 0x1.921fb54442d19p-1 },
+    { .x = 0x1.8p+0, .r = 0x1.f730bd281f69bp-1 },
+    { .x = 0x1.f8p+3, .r = 0x1.81e445233973dp+0 },
+    { .x = 0x1.fffffffffffffp+3, .r = 0x1.82250768ac529p+0 },
+    { .x = 0x1p+4, .r = 0x1.82250768ac529p+0 },
+    { .x = 0x1.2p+4, .r = 0x1.83ea8edb40f72p+0 },
+    { .x = 0x1p+27, .r = 0x1.921fb52442d18p+0 },
+    { .x = 0x1.fffffffffffffp+59, .r = 0x1.921fb54442d18p+0 },
+};
+
+#define NATAN   (sizeof(atan_vec)/sizeof(atan_vec[0]))
+
+struct atan2_vec {
+    double      y, x, r;
+};
+
+static const struct atan2_vec atan2_vec[] = {
+    { .y = 0x1p+0, .x = 0x1p+0, .r = 0x1.921fb54442d18p-1 },
+    { .y = 0x1p+0, .x = -0x1p+0, .r = 0x1.2d97c7f3321d2p+1 },
+    { .y = 0x1p-600, .x = 0x1p+0, .r = 0x1p-600 },
+    { .y = 0x1.8p+1, .x = -0x1p-20, .r = 0x1.921fba999826ep+0 },
+    { .y = 0x1.8p+0, .x = 0x1.2p+4, .r = 0x1.548be67e8f63fp-4 },
+    { .y = 0x1p+0, .x = 0x1p+4, .r = 0x1.ff55bb72cfdeap-5 },
+    { .y = 0x1p+0, .x = -0x1.0000000000001p+4, .r = 0x1.8a225e5677921p+1 },
+    { .y = 0x1.04p-4, .x = 0x1p+0, .r = 0x1.03a6d1c06693dp-4 },
+    { .y = 0x1p-1, .x = -0x1.fffffffffffffp+1, .r = 0x1.8234d7f6ecb9dp+1 },
+    { .y = 0x1p+500, .x = 0x1p-500, .r = 0x1.921fb54442d18p+0 },
+    { .y = 0x1.921fb54442d18p+0, .x = -0x1p+0, .r = 0x1.11a06904dab99p+1 },
+    { .y = 0x1p-1022, .x = -0x1p+0, .r = 0x1.921fb54442d18p+1 },
+    { .y = 0x1.5555555555555p-2, .x = 0x1.0000000000001p+0, .r = 0x1.4978fa3269eep-2 },
+};
+
+#define NATAN2  (sizeof(atan2_vec)/sizeof(atan2_vec[0]))
+
+/* asin (x), acos (x) and acos (-x) */
+struct asin_vec {
+    double      x, s, c, cn;
+};
+
+static const struct asin_vec asin_vec[] = {
+    { .x = 0x1p-30, .s = 0x1p-30, .c = 0x1.921fb54042d18p+0, .cn = 0x1.921fb54842d18p+0 },
+    { .x = 0x1p-5, .s = 0x1.000aabde0b9c8p-5, .c = 0x1.8a1f5fe55274ap+0, .cn = 0x1.9a200aa3332e7p+0 },
+    { .x = 0x1.8p-2, .s = 0x1.899f4edc962d3p-2, .c = 0x1.2fb7e18d1d464p+0, .cn = 0x1.f48788fb685cdp+0 },
+    { .x = 0x1p-1, .s = 0x1.0c152382d7366p-1, .c = 0x1.0c152382d7366p+0, .cn = 0x1.0c152382d7366p+1 },
+    { .x = 0x1.0000000000001p-1, .s = 0x1.0c152382d7367p-1, .c = 0x1.0c152382d7365p+0, .cn = 0x1.0c152382d7366p+1 },
+    { .x = 0x1.6a09e667f3bccp-1, .s = 0x1.921fb54442d17p-1, .c = 0x1.921fb54442d19p-1, .cn = 0x1.2d97c7f3321d2p+1 },
+    { .x = 0x1.6a09e667f3bcdp-1, .s = 0x1.921fb54442d19p-1, .c = 0x1.921fb54442d18p-1, .cn = 0x1.2d97c7f3321d2p+1 },
+    { .x = 0x1.ep-1, .s = 0x1.3722d2feb24c8p+0, .c = 0x1.6bf3891642142p-2, .cn = 0x1.64a144217a8fp+1 },
+    { .x = 0x1.fffffep-1, .s = 0x1.920914a5da6f9p+0, .c = 0x1.6a09e6861f3abp-12, .cn = 0x1.921464f50ea09p+1 },
+    { .x = 0x1.fffffffffffffp-1, .s = 0x1.921fb50442d18p+0, .c = 0x1p-26, .cn = 0x1.921fb52442d18p+1 },
+};
+
+#define NASIN   (sizeof(asin_vec)/sizeof(asin_vec[0]))
+
+/* Results may be off by one ULP */
+#define MAX_ULP 1
+
+static int64_t
+ulp_error(double got, double want)
+{
+    int64_t g, w;
+
+    memcpy(&g, &got, sizeof(g));
+    memcpy(&w, &want, sizeof(w));
+    if ((g < 0) != (w < 0))
+        return INT64_MAX;
+    return g > w ? g - w : w - g;
+}
+
+static int
+check(const char *name, double x, double got, double want)
+{
+    int64_t err = ulp_error(got, want);
+
+    if (err > MAX_ULP) {
+        printf("%s(%a) got %a want %a (%lld ulp)\n",
+               name, x, got, want, (long long) err);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    unsigned    i;
+    int         errors = 0;
+    double      s, c;
+
+    for (i = 0; i < NTRIG; i++) {
+        const struct trig_vec *v = &trig_vec[i];
+
+        errors += check("sin", v->x, sin(v->x), v->s);
+        errors += check("cos", v->x, cos(v->x), v->c);
+        errors += check("tan", v->x, tan(v->x), v->t);
+        sincos(v->x, &s, &c);
+        errors += check("sincos sin", v->x, s, v->s);
+        errors += check("sincos cos", v->x, c, v->c);
+
+        /* sin and tan are odd, cos is even */
+        errors += check("sin", -v->x, sin(-v->x), -v->s);
+        errors += check("cos", -v->x, cos(-v->x), v->c);
+        errors += check("tan", -v->x, tan(-v->x), -v->t);
+    }
+
+    for (i = 0; i < NATAN; i++) {
+        const struct atan_vec *v = &atan_vec[i];
+
+        errors += check("atan", v->x, atan(v->x), v->r);
+        errors += check("atan", -v->x, atan(-v->x), -v->r);
+    }
+
+    for (i = 0; i < NATAN2; i++) {
+        const struct atan2_vec *v = &atan2_vec[i];
+
+        errors += check("atan2", v->y, atan2(v->y, v->x), v->r);
+        errors += check("atan2", -v->y, atan2(-v->y, v->x), -v->r);
+    }
+
+    for (i = 0; i < NASIN; i++) {
+        const struct asin_vec *v = &asin_vec[i];
+
+        errors += check("asin", v->x, asin(v->x), v->s);
+        errors += check("asin", -v->x, asin(-v->x), -v->s);
+        errors += check("acos", v->x, acos(v->x), v->c);
+        errors += check("acos", -v->x, acos(-v->x), v->cn);
+    }
+
+    if (!signbit(sin(-0.0)) || !signbit(tan(-0.0)) || cos(-0.0) != 1.0) {
+        printf("wrong result for -0\n");
+        errors++;
+    }
+    if (!isnan(sin((double) INFINITY)) || !isnan(cos(-(double) INFINITY)) ||
+        !isnan(tan((double) NAN))) {
+        printf("wrong result for inf or nan\n");
+        errors++;
+    }
+    if (!signbit(atan(-0.0)) || !signbit(asin(-0.0)) || acos(1.0) != 0.0 ||
+        !signbit(atan2(-0.0, 1.0))) {
+        printf("wrong result for inverse of -0\n");
+        errors++;
+    }
+    if (!isnan(asin(0x1.0000000000001p+0)) || !isnan(acos(-(double) INFINITY)) ||
+        !isnan(atan((double) NAN)) || !isnan(atan2(1.0, (double) NAN))) {
+        printf("wrong result for inverse out of range, inf or nan\n");
+        errors++;
+    }
+    printf("trig: %u tests %d errors\n",
+           (unsigned) (NTRIG + NATAN + NATAN2 + NASIN), errors);
+    return errors != 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("double is not binary64, skipping trig tests\n");
+    return 77;
+}
+
+#endif
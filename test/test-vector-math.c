@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Check the vector entry points used by compilers vectorizing loops
+ * which call expf, logf, sinf, cosf and powf against the scalar
+ * functions. Each lane must match exactly, including lanes holding
+ * special values which are mixed in with ordinary ones.
+ */
+
+#if defined(__PICOLIBC__) && !__OBSOLETE_MATH_FLOAT &&                  \
+    (__GNUC_PREREQ (9, 0) || defined(__clang__)) &&                     \
+    ((defined(__x86_64__) && defined(__SSE2__)) ||                      \
+     (defined(__aarch64__) && defined(__ARM_NEON)))
+
+typedef float v4sf __attribute__ ((vector_size (16)));
+
+#ifdef __x86_64__
+#define VEC1(f) _ZGVbN4v_ ## f
+#define VEC2(f) _ZGVbN4vv_ ## f
+#define VPCS
+#else
+#define VEC1(f) _ZGVnN4v_ ## f
+#define VEC2(f) _ZGVnN4vv_ ## f
+#define VPCS __attribute__ ((aarch64_vector_pcs))
+#endif
+
+VPCS v4sf VEC1(expf) (v4sf);
+VPCS v4sf VEC1(logf) (v4sf);
+VPCS v4sf VEC1(sinf) (v4sf);
+VPCS v4sf VEC1(cosf) (v4sf);
+VPCS v4sf VEC2(powf) (v4sf, v4sf);
+
+#ifdef __x86_64__
+#include <cpuid.h>
+
+/*
+ * The AVX variants of expf and powf use their own kernels, check those
+ * too when the processor and OS support AVX
+ */
+typedef float v8sf __attribute__ ((vector_size (32)));
+
+v8sf _ZGVcN8v_expf (v8sf);
+v8sf _ZGVcN8vv_powf (v8sf, v8sf);
+
+static int
+have_avx(void)
+{
+    unsigned    a, b, c, d;
+
+    if (!__get_cpuid(1, &a, &b, &c, &d) || !(c & bit_AVX) || !(c & bit_OSXSAVE))
+        return 0;
+    __asm__("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+    return (a & 6) == 6;
+}
+
+__attribute__ ((__target__ ("avx"))) static v4sf
+avx_expf(v4sf x)
+{
+    v8sf r = _ZGVcN8v_expf((v8sf) { 0, 0, 0, 0, x[0], x[1], x[2], x[3] });
+
+    return (v4sf) { r[4], r[5], r[6], r[7] };
+}
+
+__attribute__ ((__target__ ("avx"))) static v4sf
+avx_powf(v4sf x, v4sf y)
+{
+    v8sf r = _ZGVcN8vv_powf((v8sf) { 1, 1, 1, 1, x[0], x[1], x[2], x[3] },
+                            (v8sf) { 1, 1, 1, 1, y[0], y[1], y[2], y[3] });
+
+    return (v4sf) { r[4], r[5], r[6], r[7] };
+}
+#endif
+
+static const float inputs[] = {
+    0.0f, -0.0f, 0x1p-149f, -0x1p-130f, 0x1p-126f, 0x1p-20f, -0x1p-12f,
+    0.25f, -0.5f, 0.75f, 1.0f, -1.0f, 0x1.fffffep-1f, 1.5f, 2.0f, -3.0f,
+    3.14159274f, 10.0f, -17.5f, 42.0f, 87.0f, 88.0f, -88.5f, 88.8f,
+    -104.0f, 119.0f, -120.0f, 1e10f, -0x1p100f, (float) INFINITY,
+    -(float) INFINITY, (float) NAN,
+};
+
+#define NINPUT  (sizeof(inputs)/sizeof(inputs[0]))
+
+static int
+same(float a, float b)
+{
+    uint32_t ua, ub;
+
+    if (isnan(a) && isnan(b))
+        return 1;
+    memcpy(&ua, &a, sizeof(ua));
+    memcpy(&ub, &b, sizeof(ub));
+    return ua == ub;
+}
+
+static int
+check(const char *name, v4sf x, v4sf y, v4sf got, const float *want)
+{
+    int errors = 0;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        if (!same(got[i], want[i])) {
+            printf("%s(%a, %a) lane %d got %a want %a\n",
+                   name, (double) x[i], (double) y[i], i,
+                   (double) got[i], (double) want[i]);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int
+main(void)
+{
+    unsigned    i, j;
+    int         errors = 0;
+    int         tests = 0;
+#ifdef __x86_64__
+    int         avx = have_avx();
+#endif
+
+    /* Step through the inputs by different amounts so that each
+     * vector mixes special and ordinary values */
+    for (i = 0; i < NINPUT; i++) {
+        for (j = 1; j < NINPUT; j += 3) {
+            v4sf        x, y;
+            float       want[4];
+            int         l;
+
+            for (l = 0; l < 4; l++) {
+                x[l] = inputs[(i + l * j) % NINPUT];
+                y[l] = inputs[(i + l * j + 1) % NINPUT];
+            }
+
+            for (l = 0; l < 4; l++)
+                want[l] = expf(x[l]);
+            errors += check("expf", x, y, VEC1(expf)(x), want);
+            for (l = 0; l < 4; l++)
+                want[l] = logf(x[l]);
+            errors += check("logf", x, y, VEC1(logf)(x), want);
+            for (l = 0; l < 4; l++)
+                want[l] = sinf(x[l]);
+            errors += check("sinf", x, y, VEC1(sinf)(x), want);
+            for (l = 0; l < 4; l++)
+                want[l] = cosf(x[l]);
+            errors += check("cosf", x, y, VEC1(cosf)(x), want);
+            for (l = 0; l < 4; l++)
+                want[l] = powf(x[l], y[l]);
+            errors += check("powf", x, y, VEC2(powf)(x, y), want);
+            tests += 5;
+#ifdef __x86_64__
+            if (avx) {
+                for (l = 0; l < 4; l++)
+                    want[l] = expf(x[l]);
+                errors += check("avx expf", x, y, avx_expf(x), want);
+                for (l = 0; l < 4; l++)
+                    want[l] = powf(x[l], y[l]);
+                errors += check("avx powf", x, y, avx_powf(x, y), want);
+                tests += 2;
+            }
+#endif
+        }
+    }
+    printf("vector math: %d tests %d errors\n", tests, errors);
+    return errors != 0;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("no vector math functions, skipping\n");
+    return 77;
+}
+
+#endif
@@ -267,5 +267,37 @@ main(void)
       ret = 1;
   }
 
+  // Changing TZ should take effect without calling tzset().
+
+  struct tm dtForMktime9;
+  init_struct_tm( &dtForMktime9 );
+  dtForMktime9.tm_mday  = 1;
+  dtForMktime9.tm_year  = 1970 - TIME_TM_YEAR_BASE;
+
+  struct tm dtForMktime10 = dtForMktime9;
+  struct tm dtForMktime11 = dtForMktime9;
+
+  if ( mktime( &dtForMktime9 ) != -1 * 60 * 60 )
+  {
+    puts("Test t9 failed.");
+    ret = 1;
+  }
+
+  setenv( "TZ", "ART3", 1 );
+
+  if ( mktime( &dtForMktime10 ) != 3 * 60 * 60 )
+  {
+    puts("Test t10 failed.");
+    ret = 1;
+  }
+
+  unsetenv( "TZ" );
+
+  if ( mktime( &dtForMktime11 ) != 0 )
+  {
+    puts("Test t11 failed.");
+    ret = 1;
+  }
+
   return ret;
 }
@@ -126,5 +126,39 @@ int main(void)
 			ret++;
 		}
 	}
+
+	/* Walk the whole range of years accepted by timegm */
+	if (sizeof(time_t) >= 8) {
+		int		year;
+		time_t		prev = 0;
+
+		for (year = -10000; year <= 10000; year++) {
+			struct tm	tm = { .tm_mday = 1, .tm_year = year };
+			struct tm	*ptm;
+			time_t		time;
+			int		y = year + 1899;
+
+			time = timegm(&tm);
+			if (year > -10000 && time - prev != (time_t) (365 + (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0))) * 86400) {
+				printf("timegm year %d: got %lld prev %lld\n", year, (long long) time, (long long) prev);
+				ret++;
+			}
+			prev = time;
+			ptm = gmtime(&time);
+			if (ptm->tm_year != year || ptm->tm_mon != 0 || ptm->tm_mday != 1 || ptm->tm_yday != 0 ||
+			    ptm->tm_wday != tm.tm_wday) {
+				printf("gmtime year %d: got %d-%d-%d\n", year, ptm->tm_year, ptm->tm_mon, ptm->tm_mday);
+				ret++;
+			}
+
+			/* Out of range days are folded into the month and year */
+			struct tm	day = { .tm_mday = 1 + (year % 1000) * 1000, .tm_year = 100 };
+			time = timegm(&day);
+			if (time != 946684800 + (time_t) (year % 1000) * 1000 * 86400) {
+				printf("timegm mday %d: got %lld\n", 1 + (year % 1000) * 1000, (long long) time);
+				ret++;
+			}
+		}
+	}
 	return ret;
 }